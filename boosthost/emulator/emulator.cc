@@ -189,7 +189,9 @@ int main(int argc, char** argv) {
       "minimal heap size in MB")
     ("max-memory", po::value<size_t>(&maxMemoryMega),
       "maximum heap size in MB")
-    ("gui", "GUI mode");
+    ("gui", "GUI mode")
+    ("perf-map", "write /tmp/perf-<pid>.map so that Linux perf can "
+      "attribute time to Oz procedures");
 
   po::options_description hidden("Hidden options");
   hidden.add_options()
@@ -289,6 +291,7 @@ int main(int argc, char** argv) {
   bool useBaseFunctor = varMap.count("base") != 0;
 
   appGUI = varMap.count("gui") != 0;
+  bool perfMap = varMap.count("perf-map") != 0;
 
   // SET UP THE VM AND RUN
   boostenv::BoostEnvironment boostEnv([=] (VM vm, std::unique_ptr<std::string> app, bool isURL) {
@@ -339,6 +342,10 @@ int main(int argc, char** argv) {
         vm, "application.gui", appGUI);
     }
 
+    // Also for the VMs created by the program
+    if (perfMap)
+      vm->getPerfMap().setEnabled(true);
+
     boostenv::BoostEnvironment& boostEnv = boostenv::BoostEnvironment::forVM(vm);
 
     // Some protected nodes
@@ -27,10 +27,15 @@
 
 #include <mozart.hh>
 
+#include <algorithm>
 #include <ctime>
 #include <cstdio>
 #include <cerrno>
+#include <deque>
 #include <forward_list>
+#include <map>
+#include <memory>
+#include <vector>
 
 #include <boost/thread.hpp>
 
@@ -63,6 +68,9 @@ public:
   inline
   BoostEnvironment(const VMStarter& vmStarter);
 
+  inline
+  ~BoostEnvironment();
+
 // VM Management
 // All public functions may be called by any thread!
 
@@ -163,6 +171,32 @@ public:
   inline
   void sendOnVMPort(VM from, VMIdentifier to, RichNode value);
 
+// Code shared by all the VMs
+
+public:
+  inline
+  std::shared_ptr<const std::vector<ByteCode>> getSharedCodeBlock(
+    const UUID& uuid, const ByteCode* codeBlock, size_t size);
+
+// Work shared between threads
+
+public:
+  size_t getParallelism() {
+    return std::max(1u, boost::thread::hardware_concurrency());
+  }
+
+  /**
+   * The ranges are run by a pool of worker threads, started on first use
+   * and shared by all the VMs, and by the calling thread itself.
+   */
+  inline
+  void parallelFor(size_t count,
+                   const std::function<void(size_t, size_t)>& body);
+
+private:
+  inline
+  void runWorker();
+
 // GC
 
 public:
@@ -192,6 +226,24 @@ public:
   const BootLoader bootLoader;
   const VMStarter vmStarter;
 
+// Code shared by all the VMs
+private:
+  // The code areas that run a block own it, so that the blocks of functors
+  // that are not used any more, e.g., recompiled ones, are freed. Entries of
+  // freed blocks are forgotten once the table doubled since it was last
+  // cleaned up.
+  std::map<UUID, std::weak_ptr<const std::vector<ByteCode>>> _sharedCodeBlocks;
+  size_t _sharedCodeBlocksCleanupSize;
+  boost::mutex _sharedCodeBlocksMutex;
+
+// Work shared between threads
+private:
+  std::deque<std::function<void()>> _work;
+  boost::mutex _workMutex;
+  boost::condition_variable _workAvailable;
+  boost::thread_group _workers;
+  bool _stopWorkers;
+
 // Unsafe process-wide operations
 private:
   boost::mutex _environmentVariablesMutex;
@@ -25,9 +25,13 @@
 #ifndef MOZART_BOOSTENV_H
 #define MOZART_BOOSTENV_H
 
+#include <algorithm>
 #include <csignal>
 #include <exception>
 #include <fstream>
+#include <memory>
+
+#include <sys/stat.h>
 
 #include "boostenv-decl.hh"
 
@@ -100,13 +104,51 @@ namespace internal {
       return url;
   }
 
+  /**
+   * Read a boot file (Init.ozf or a functor it loads) in memory
+   * Returns false if it is not a regular file that can be read.
+   */
   inline
-  bool defaultBootLoader(VM vm, const std::string& url, UnstableNode& result) {
-    std::string filename = decodedURLToFilename(decodeURL(url));
+  bool readBootFile(const std::string& filename,
+                    std::vector<unsigned char>& image) {
+    struct stat status;
+    if ((stat(filename.c_str(), &status) != 0) || !S_ISREG(status.st_mode))
+      return false;
+
     std::ifstream input(filename, std::ios::binary);
     if (!input.is_open())
       return false;
-    result = unpickle(vm, input);
+
+    image.resize((size_t) status.st_size);
+    input.read(reinterpret_cast<char*>(image.data()), image.size());
+    image.resize((size_t) input.gcount());
+    return true;
+  }
+
+  inline
+  bool defaultBootLoader(VM vm, const std::string& url, UnstableNode& result) {
+    std::string filename = decodedURLToFilename(decodeURL(url));
+
+    std::vector<unsigned char> image;
+    if (!readBootFile(filename, image)) {
+      // Not a regular file, e.g., a pipe
+      std::ifstream input(filename, std::ios::binary);
+      if (!input.is_open())
+        return false;
+      result = unpickle(vm, input);
+      return true;
+    }
+
+    // Procedures are decoded lazily from copies of their own byte-code, so
+    // that the image is freed as soon as it is unpickled
+    MOZART_TRY(vm) {
+      result = unpickleLazily(vm, image.data(), image.size());
+    } MOZART_CATCH(vm, kind, node) {
+      // The raise skips the destructors of image and filename
+      std::vector<unsigned char>().swap(image);
+      std::string().swap(filename);
+      MOZART_RETHROW(vm);
+    } MOZART_ENDTRY(vm);
     return true;
   }
 }
@@ -114,13 +156,23 @@ namespace internal {
 BoostEnvironment::BoostEnvironment(const VMStarter& vmStarter) :
   _nextVMIdentifier(InitialVMIdentifier), _exitCode(0),
   bootLoader(&internal::defaultBootLoader),
-  vmStarter(vmStarter) {
+  vmStarter(vmStarter), _sharedCodeBlocksCleanupSize(64),
+  _stopWorkers(false) {
   // Ignore SIGPIPE ourselves since Boost does not always do it
 #ifdef SIGPIPE
   std::signal(SIGPIPE, SIG_IGN);
 #endif
 }
 
+BoostEnvironment::~BoostEnvironment() {
+  {
+    boost::lock_guard<boost::mutex> lock(_workMutex);
+    _stopWorkers = true;
+  }
+  _workAvailable.notify_all();
+  _workers.join_all();
+}
+
 VMIdentifier BoostEnvironment::addVM(VMIdentifier parent,
                                      std::unique_ptr<std::string>&& app, bool isURL,
                                      VirtualMachineOptions options) {
@@ -201,6 +253,110 @@ int BoostEnvironment::runIO() {
   return _exitCode;
 }
 
+std::shared_ptr<const std::vector<ByteCode>>
+BoostEnvironment::getSharedCodeBlock(
+  const UUID& uuid, const ByteCode* codeBlock, size_t size) {
+
+  boost::lock_guard<boost::mutex> lock(_sharedCodeBlocksMutex);
+
+  auto iter = _sharedCodeBlocks.find(uuid);
+  if (iter != _sharedCodeBlocks.end()) {
+    if (auto block = iter->second.lock()) {
+      if (block->size() * sizeof(ByteCode) != size ||
+          !std::equal(block->begin(), block->end(), codeBlock)) {
+        // Same UUID but different code: do not share
+        return nullptr;
+      }
+      return block;
+    }
+  }
+
+  if (_sharedCodeBlocks.size() >= 2 * _sharedCodeBlocksCleanupSize) {
+    for (auto entry = _sharedCodeBlocks.begin();
+         entry != _sharedCodeBlocks.end(); ) {
+      if (entry->second.expired())
+        entry = _sharedCodeBlocks.erase(entry);
+      else
+        ++entry;
+    }
+    _sharedCodeBlocksCleanupSize = std::max<size_t>(
+      _sharedCodeBlocks.size(), 64);
+  }
+
+  auto block = std::make_shared<const std::vector<ByteCode>>(
+    codeBlock, codeBlock + size / sizeof(ByteCode));
+  _sharedCodeBlocks[uuid] = block;
+  return block;
+}
+
+void BoostEnvironment::parallelFor(
+  size_t count, const std::function<void(size_t, size_t)>& body) {
+
+  size_t threadCount = std::min(getParallelism(), count);
+  if (threadCount <= 1) {
+    body(0, count);
+    return;
+  }
+
+  size_t rangeSize = (count + threadCount - 1) / threadCount;
+  size_t pending = 0;
+  boost::condition_variable done;
+
+  {
+    boost::lock_guard<boost::mutex> lock(_workMutex);
+
+    if (_workers.size() == 0) {
+      for (size_t i = 1; i < getParallelism(); i++)
+        _workers.create_thread([this] { runWorker(); });
+    }
+
+    for (size_t from = rangeSize; from < count; from += rangeSize) {
+      size_t to = std::min(from + rangeSize, count);
+      pending++;
+      _work.push_back([this, &body, &pending, &done, from, to] {
+        body(from, to);
+        boost::lock_guard<boost::mutex> lock(_workMutex);
+        if (--pending == 0)
+          done.notify_all();
+      });
+    }
+  }
+  _workAvailable.notify_all();
+
+  // The calling thread takes the first range itself, then helps with the
+  // queued ones rather than waiting for busy workers
+  body(0, rangeSize);
+
+  boost::unique_lock<boost::mutex> lock(_workMutex);
+  while (pending > 0) {
+    if (_work.empty()) {
+      done.wait(lock);
+    } else {
+      auto work = std::move(_work.front());
+      _work.pop_front();
+      lock.unlock();
+      work();
+      lock.lock();
+    }
+  }
+}
+
+void BoostEnvironment::runWorker() {
+  boost::unique_lock<boost::mutex> lock(_workMutex);
+  while (true) {
+    while (_work.empty() && !_stopWorkers)
+      _workAvailable.wait(lock);
+    if (_stopWorkers)
+      return;
+
+    auto work = std::move(_work.front());
+    _work.pop_front();
+    lock.unlock();
+    work();
+    lock.lock();
+  }
+}
+
 void BoostEnvironment::withSecondMemoryManager(const std::function<void(MemoryManager&)>& doGC) {
   // Disallow concurrent GCs, so only one has access to the second MemoryManager
   // at a time and we have a much lower maximal memory footprint.
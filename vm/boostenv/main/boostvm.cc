@@ -249,10 +249,12 @@ void BoostVM::sendOnVMPort(VMIdentifier to, RichNode value) {
   if (portClosed)
     return;
 
-  std::ostringstream out;
-  pickle(vm, value, out);
-  // allocates the buffer in a neutral zone: the heap
-  std::string* buffer = new std::string(out.str());
+  // Pickle directly in a buffer allocated in a neutral zone: the heap.
+  // The receiver unpickles from that buffer without copying it again, and
+  // its large byte strings keep using the bytes in the buffer.
+  std::unique_ptr<std::string> message(new std::string());
+  pickle(vm, value, *message);
+  std::string* buffer = message.release();
 
   bool found = env.postVMEvent(to, [buffer] (BoostVM& targetVM) {
     targetVM.receiveOnVMStream(buffer);
@@ -272,9 +274,9 @@ void BoostVM::receiveOnVMStream(std::string* buffer) {
     return;
   }
 
-  std::istringstream input(*buffer);
-  UnstableNode unpickled = unpickle(vm, input);
-  delete buffer;
+  // Large byte strings of the message keep pointing into its buffer
+  std::shared_ptr<const std::string> message(buffer);
+  UnstableNode unpickled = unpickleShared(vm, message);
 
   sendToReadOnlyStream(vm, _stream, unpickled);
 }
@@ -18,6 +18,7 @@ public:
     instanceFopen.setModuleName("OS");
     instanceFread.setModuleName("OS");
     instanceFwrite.setModuleName("OS");
+    instanceFwritePickle.setModuleName("OS");
     instanceFseek.setModuleName("OS");
     instanceFclose.setModuleName("OS");
     instanceStdin.setModuleName("OS");
@@ -43,7 +44,7 @@ public:
     instanceGetHostByName.setModuleName("OS");
     instanceUName.setModuleName("OS");
 
-    UnstableField fields[37];
+    UnstableField fields[38];
     fields[0].feature = build(vm, "bootURLLoad");
     fields[0].value = build(vm, instanceBootURLLoad);
     fields[1].feature = build(vm, "rand");
@@ -70,56 +71,58 @@ public:
     fields[11].value = build(vm, instanceFread);
     fields[12].feature = build(vm, "fwrite");
     fields[12].value = build(vm, instanceFwrite);
-    fields[13].feature = build(vm, "fseek");
-    fields[13].value = build(vm, instanceFseek);
-    fields[14].feature = build(vm, "fclose");
-    fields[14].value = build(vm, instanceFclose);
-    fields[15].feature = build(vm, "stdin");
-    fields[15].value = build(vm, instanceStdin);
-    fields[16].feature = build(vm, "stdout");
-    fields[16].value = build(vm, instanceStdout);
-    fields[17].feature = build(vm, "stderr");
-    fields[17].value = build(vm, instanceStderr);
-    fields[18].feature = build(vm, "system");
-    fields[18].value = build(vm, instanceSystem);
-    fields[19].feature = build(vm, "tcpAcceptorCreate");
-    fields[19].value = build(vm, instanceTCPAcceptorCreate);
-    fields[20].feature = build(vm, "tcpAccept");
-    fields[20].value = build(vm, instanceTCPAccept);
-    fields[21].feature = build(vm, "tcpCancelAccept");
-    fields[21].value = build(vm, instanceTCPCancelAccept);
-    fields[22].feature = build(vm, "tcpAcceptorClose");
-    fields[22].value = build(vm, instanceTCPAcceptorClose);
-    fields[23].feature = build(vm, "tcpConnect");
-    fields[23].value = build(vm, instanceTCPConnect);
-    fields[24].feature = build(vm, "tcpConnectionRead");
-    fields[24].value = build(vm, instanceTCPConnectionRead);
-    fields[25].feature = build(vm, "tcpConnectionWrite");
-    fields[25].value = build(vm, instanceTCPConnectionWrite);
-    fields[26].feature = build(vm, "tcpConnectionShutdown");
-    fields[26].value = build(vm, instanceTCPConnectionShutdown);
-    fields[27].feature = build(vm, "tcpConnectionClose");
-    fields[27].value = build(vm, instanceTCPConnectionClose);
-    fields[28].feature = build(vm, "exec");
-    fields[28].value = build(vm, instanceExec);
-    fields[29].feature = build(vm, "pipe");
-    fields[29].value = build(vm, instancePipe);
-    fields[30].feature = build(vm, "pipeConnectionRead");
-    fields[30].value = build(vm, instancePipeConnectionRead);
-    fields[31].feature = build(vm, "pipeConnectionWrite");
-    fields[31].value = build(vm, instancePipeConnectionWrite);
-    fields[32].feature = build(vm, "pipeConnectionShutdown");
-    fields[32].value = build(vm, instancePipeConnectionShutdown);
-    fields[33].feature = build(vm, "pipeConnectionClose");
-    fields[33].value = build(vm, instancePipeConnectionClose);
-    fields[34].feature = build(vm, "getPID");
-    fields[34].value = build(vm, instanceGetPID);
-    fields[35].feature = build(vm, "getHostByName");
-    fields[35].value = build(vm, instanceGetHostByName);
-    fields[36].feature = build(vm, "uName");
-    fields[36].value = build(vm, instanceUName);
+    fields[13].feature = build(vm, "fwritePickle");
+    fields[13].value = build(vm, instanceFwritePickle);
+    fields[14].feature = build(vm, "fseek");
+    fields[14].value = build(vm, instanceFseek);
+    fields[15].feature = build(vm, "fclose");
+    fields[15].value = build(vm, instanceFclose);
+    fields[16].feature = build(vm, "stdin");
+    fields[16].value = build(vm, instanceStdin);
+    fields[17].feature = build(vm, "stdout");
+    fields[17].value = build(vm, instanceStdout);
+    fields[18].feature = build(vm, "stderr");
+    fields[18].value = build(vm, instanceStderr);
+    fields[19].feature = build(vm, "system");
+    fields[19].value = build(vm, instanceSystem);
+    fields[20].feature = build(vm, "tcpAcceptorCreate");
+    fields[20].value = build(vm, instanceTCPAcceptorCreate);
+    fields[21].feature = build(vm, "tcpAccept");
+    fields[21].value = build(vm, instanceTCPAccept);
+    fields[22].feature = build(vm, "tcpCancelAccept");
+    fields[22].value = build(vm, instanceTCPCancelAccept);
+    fields[23].feature = build(vm, "tcpAcceptorClose");
+    fields[23].value = build(vm, instanceTCPAcceptorClose);
+    fields[24].feature = build(vm, "tcpConnect");
+    fields[24].value = build(vm, instanceTCPConnect);
+    fields[25].feature = build(vm, "tcpConnectionRead");
+    fields[25].value = build(vm, instanceTCPConnectionRead);
+    fields[26].feature = build(vm, "tcpConnectionWrite");
+    fields[26].value = build(vm, instanceTCPConnectionWrite);
+    fields[27].feature = build(vm, "tcpConnectionShutdown");
+    fields[27].value = build(vm, instanceTCPConnectionShutdown);
+    fields[28].feature = build(vm, "tcpConnectionClose");
+    fields[28].value = build(vm, instanceTCPConnectionClose);
+    fields[29].feature = build(vm, "exec");
+    fields[29].value = build(vm, instanceExec);
+    fields[30].feature = build(vm, "pipe");
+    fields[30].value = build(vm, instancePipe);
+    fields[31].feature = build(vm, "pipeConnectionRead");
+    fields[31].value = build(vm, instancePipeConnectionRead);
+    fields[32].feature = build(vm, "pipeConnectionWrite");
+    fields[32].value = build(vm, instancePipeConnectionWrite);
+    fields[33].feature = build(vm, "pipeConnectionShutdown");
+    fields[33].value = build(vm, instancePipeConnectionShutdown);
+    fields[34].feature = build(vm, "pipeConnectionClose");
+    fields[34].value = build(vm, instancePipeConnectionClose);
+    fields[35].feature = build(vm, "getPID");
+    fields[35].value = build(vm, instanceGetPID);
+    fields[36].feature = build(vm, "getHostByName");
+    fields[36].value = build(vm, instanceGetHostByName);
+    fields[37].feature = build(vm, "uName");
+    fields[37].value = build(vm, instanceUName);
     UnstableNode label = build(vm, "export");
-    UnstableNode module = buildRecordDynamic(vm, label, 37, fields);
+    UnstableNode module = buildRecordDynamic(vm, label, 38, fields);
     initModule(vm, std::move(module));
   }
 private:
@@ -136,6 +139,7 @@ private:
   mozart::boostenv::builtins::ModOS::Fopen instanceFopen;
   mozart::boostenv::builtins::ModOS::Fread instanceFread;
   mozart::boostenv::builtins::ModOS::Fwrite instanceFwrite;
+  mozart::boostenv::builtins::ModOS::FwritePickle instanceFwritePickle;
   mozart::boostenv::builtins::ModOS::Fseek instanceFseek;
   mozart::boostenv::builtins::ModOS::Fclose instanceFclose;
   mozart::boostenv::builtins::ModOS::Stdin instanceStdin;
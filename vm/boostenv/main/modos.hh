@@ -220,6 +220,57 @@ private:
     bool _closed;
   };
 
+  /**
+   * Stream buffer that writes to a file through a bounded buffer
+   * Writes block while the file is a pipe or a socket whose reader lags
+   * behind, so that the writer never gets more than one buffer ahead.
+   */
+  class FileOutputBuffer: public std::streambuf {
+  public:
+    FileOutputBuffer(std::FILE* file):
+      _file(file), _buffer(64 * 1024), _failed(false) {
+      setp(_buffer.data(), _buffer.data() + _buffer.size());
+    }
+
+    bool failed() {
+      return _failed;
+    }
+
+    /** Free the buffer, dropping what it holds */
+    void release() {
+      std::vector<char>().swap(_buffer);
+      setp(nullptr, nullptr);
+    }
+
+  protected:
+    int_type overflow(int_type ch) {
+      if (!flushBuffer())
+        return traits_type::eof();
+      if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(ch);
+        pbump(1);
+      }
+      return traits_type::not_eof(ch);
+    }
+
+    int sync() {
+      return flushBuffer() ? 0 : -1;
+    }
+
+  private:
+    bool flushBuffer() {
+      size_t size = pptr() - pbase();
+      if (!_failed && std::fwrite(pbase(), 1, size, _file) != size)
+        _failed = true;
+      setp(_buffer.data(), _buffer.data() + _buffer.size());
+      return !_failed;
+    }
+
+    std::FILE* _file;
+    std::vector<char> _buffer;
+    bool _failed;
+  };
+
   static WrappedFile* getFileArgument(VM vm, RichNode arg) {
     auto wrappedFile = getPointerArgument<WrappedFile>(vm, arg, "file");
 
@@ -407,6 +458,34 @@ public:
     }
   };
 
+  class FwritePickle: public Builtin<FwritePickle> {
+  public:
+    FwritePickle(): Builtin("fwritePickle") {}
+
+    static void call(VM vm, In fileNode, In value, In temporaryReplacement) {
+      auto file = getFileArgument(vm, fileNode)->file();
+
+      bool failed;
+      {
+        FileOutputBuffer buffer(file);
+        std::ostream output(&buffer);
+        MOZART_TRY(vm) {
+          pickle(vm, value, temporaryReplacement, output);
+        } MOZART_CATCH(vm, kind, node) {
+          // The raise skips the destructor of buffer
+          buffer.release();
+          MOZART_RETHROW(vm);
+        } MOZART_ENDTRY(vm);
+        output.flush();
+
+        failed = buffer.failed() || (std::fflush(file) != 0);
+      }
+
+      if (failed)
+        raiseLastOSError(vm, "fwrite");
+    }
+  };
+
   class Fseek: public Builtin<Fseek> {
   public:
     Fseek(): Builtin("fseek") {}
@@ -82,9 +82,8 @@ public:
       if (isURL) {
         appStr.reset(new std::string(appURL.contents()));
       } else { // app is a pickled functor
-        std::ostringstream out;
-        pickle(vm, app, out);
-        appStr.reset(new std::string(out.str()));
+        appStr.reset(new std::string());
+        pickle(vm, app, *appStr);
       }
 
       // inherit memory settings
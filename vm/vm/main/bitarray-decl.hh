@@ -0,0 +1,177 @@
+// Copyright © 2014, Université catholique de Louvain
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// *  Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// *  Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MOZART_BITARRAY_DECL_H
+#define MOZART_BITARRAY_DECL_H
+
+#include "mozartcore-decl.hh"
+
+namespace mozart {
+
+//////////////
+// BitArray //
+//////////////
+
+#ifndef MOZART_GENERATOR
+#include "BitArray-implem-decl.hh"
+#endif
+
+/**
+ * Packed array of bits indexed from low to high
+ * Bits are stored in 64-bit words, bit i of the array being bit
+ * (i - low) % 64 of word (i - low) / 64. The padding bits of the last word
+ * are always zero, so that the word-level operations need not mask them.
+ */
+class BitArray: public DataType<BitArray>, public WithHome,
+  StoredWithArrayOf<std::uint64_t> {
+public:
+  typedef std::uint64_t Word;
+
+  static constexpr size_t bitsPerWord = 64;
+
+  static atom_t getTypeAtom(VM vm) {
+    return vm->getAtom("bitArray");
+  }
+
+  static size_t wordCountFor(size_t width) {
+    return (width + bitsPerWord - 1) / bitsPerWord;
+  }
+
+  inline
+  BitArray(VM vm, size_t wordCount, nativeint low, nativeint high);
+
+  inline
+  BitArray(VM vm, size_t wordCount, BitArray& from);
+
+  inline
+  BitArray(VM vm, size_t wordCount, GR gr, BitArray& from);
+
+public:
+  // Requirement for StoredWithArrayOf
+  size_t getArraySizeImpl() {
+    return wordCountFor(getWidth());
+  }
+
+public:
+  nativeint getLow() {
+    return _low;
+  }
+
+  nativeint getHigh() {
+    return _high;
+  }
+
+  size_t getWidth() {
+    return (size_t) (_high - _low + 1);
+  }
+
+public:
+  // Operations
+
+  inline
+  UnstableNode low(VM vm);
+
+  inline
+  UnstableNode high(VM vm);
+
+  inline
+  bool test(RichNode self, VM vm, RichNode index);
+
+  inline
+  void set(RichNode self, VM vm, RichNode index);
+
+  inline
+  void clear(RichNode self, VM vm, RichNode index);
+
+  inline
+  UnstableNode clone(VM vm);
+
+  inline
+  void disj(RichNode self, VM vm, RichNode other);
+
+  inline
+  void conj(RichNode self, VM vm, RichNode other);
+
+  inline
+  void exclDisj(RichNode self, VM vm, RichNode other);
+
+  inline
+  void nimpl(RichNode self, VM vm, RichNode other);
+
+  inline
+  bool disjoint(RichNode self, VM vm, RichNode other);
+
+  inline
+  bool subsumes(VM vm, RichNode other);
+
+  inline
+  size_t card(VM vm);
+
+  inline
+  UnstableNode toList(VM vm);
+
+  inline
+  UnstableNode complementToList(VM vm);
+
+public:
+  // Miscellaneous
+
+  void printReprToStream(VM vm, std::ostream& out, int depth, int width) {
+    out << "<BitArray " << _low << ".." << _high << ">";
+  }
+
+private:
+  inline
+  size_t getOffset(RichNode self, VM vm, RichNode index);
+
+  inline
+  static void requireBitArray(VM vm, RichNode value);
+
+  inline
+  Word* getOperandWords(RichNode self, VM vm, RichNode other);
+
+  template <class WordOp>
+  inline
+  void combine(RichNode self, VM vm, RichNode other, WordOp op);
+
+  template <class WordOp>
+  inline
+  UnstableNode indicesToList(VM vm, WordOp op);
+
+  Word lastWordMask() {
+    size_t usedBits = getWidth() % bitsPerWord;
+    return (usedBits == 0) ? ~(Word) 0 : (((Word) 1 << usedBits) - 1);
+  }
+
+  nativeint _low;
+  nativeint _high;
+};
+
+#ifndef MOZART_GENERATOR
+#include "BitArray-implem-decl-after.hh"
+#endif
+
+}
+
+#endif // MOZART_BITARRAY_DECL_H
@@ -0,0 +1,258 @@
+// Copyright © 2014, Université catholique de Louvain
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// *  Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// *  Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MOZART_BITARRAY_H
+#define MOZART_BITARRAY_H
+
+#include "mozartcore.hh"
+
+#include <algorithm>
+
+#ifndef MOZART_GENERATOR
+
+namespace mozart {
+
+//////////////
+// BitArray //
+//////////////
+
+#include "BitArray-implem.hh"
+
+BitArray::BitArray(VM vm, size_t wordCount, nativeint low, nativeint high):
+  WithHome(vm) {
+
+  _low = low;
+  _high = high;
+
+  Word* words = getElementsArray();
+  std::fill(words, words + wordCount, (Word) 0);
+}
+
+BitArray::BitArray(VM vm, size_t wordCount, BitArray& from):
+  WithHome(vm) {
+
+  _low = from._low;
+  _high = from._high;
+
+  Word* fromWords = from.getElementsArray();
+  std::copy(fromWords, fromWords + wordCount, (Word*) getElementsArray());
+}
+
+BitArray::BitArray(VM vm, size_t wordCount, GR gr, BitArray& from):
+  WithHome(vm, gr, from) {
+
+  _low = from._low;
+  _high = from._high;
+
+  Word* fromWords = from.getElementsArray();
+  std::copy(fromWords, fromWords + wordCount, (Word*) getElementsArray());
+}
+
+UnstableNode BitArray::low(VM vm) {
+  return mozart::build(vm, _low);
+}
+
+UnstableNode BitArray::high(VM vm) {
+  return mozart::build(vm, _high);
+}
+
+bool BitArray::test(RichNode self, VM vm, RichNode index) {
+  size_t offset = getOffset(self, vm, index);
+  return (getElements(offset / bitsPerWord) >> (offset % bitsPerWord)) & 1;
+}
+
+void BitArray::set(RichNode self, VM vm, RichNode index) {
+  if (!isHomedInCurrentSpace(vm))
+    raise(vm, "globalState", "bitArray");
+
+  size_t offset = getOffset(self, vm, index);
+  getElements(offset / bitsPerWord) |= (Word) 1 << (offset % bitsPerWord);
+}
+
+void BitArray::clear(RichNode self, VM vm, RichNode index) {
+  if (!isHomedInCurrentSpace(vm))
+    raise(vm, "globalState", "bitArray");
+
+  size_t offset = getOffset(self, vm, index);
+  getElements(offset / bitsPerWord) &= ~((Word) 1 << (offset % bitsPerWord));
+}
+
+UnstableNode BitArray::clone(VM vm) {
+  return BitArray::build(vm, getArraySize(), *this);
+}
+
+void BitArray::disj(RichNode self, VM vm, RichNode other) {
+  combine(self, vm, other, [] (Word left, Word right) {
+    return left | right;
+  });
+}
+
+void BitArray::conj(RichNode self, VM vm, RichNode other) {
+  combine(self, vm, other, [] (Word left, Word right) {
+    return left & right;
+  });
+}
+
+void BitArray::exclDisj(RichNode self, VM vm, RichNode other) {
+  combine(self, vm, other, [] (Word left, Word right) {
+    return left ^ right;
+  });
+}
+
+void BitArray::nimpl(RichNode self, VM vm, RichNode other) {
+  combine(self, vm, other, [] (Word left, Word right) {
+    return left & ~right;
+  });
+}
+
+bool BitArray::disjoint(RichNode self, VM vm, RichNode other) {
+  Word* words = getElementsArray();
+  Word* otherWords = getOperandWords(self, vm, other);
+
+  for (size_t i = 0; i < getArraySize(); i++) {
+    if ((words[i] & otherWords[i]) != 0)
+      return false;
+  }
+
+  return true;
+}
+
+bool BitArray::subsumes(VM vm, RichNode other) {
+  requireBitArray(vm, other);
+  auto otherArray = other.as<BitArray>();
+
+  if ((otherArray.getLow() < _low) || (otherArray.getHigh() > _high))
+    return false;
+
+  Word* words = getElementsArray();
+  Word* otherWords = otherArray.getElementsArray();
+  size_t otherWordCount = otherArray.getArraySize();
+  size_t shift = (size_t) (otherArray.getLow() - _low);
+
+  if (shift == 0) {
+    for (size_t i = 0; i < otherWordCount; i++) {
+      if ((otherWords[i] & ~words[i]) != 0)
+        return false;
+    }
+  } else {
+    for (size_t i = 0; i < otherWordCount; i++) {
+      for (Word word = otherWords[i]; word != 0; word &= word - 1) {
+        size_t offset = shift + i * bitsPerWord + __builtin_ctzll(word);
+        if (((words[offset / bitsPerWord] >> (offset % bitsPerWord)) & 1) == 0)
+          return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+size_t BitArray::card(VM vm) {
+  Word* words = getElementsArray();
+  size_t result = 0;
+
+  for (size_t i = 0; i < getArraySize(); i++)
+    result += __builtin_popcountll(words[i]);
+
+  return result;
+}
+
+UnstableNode BitArray::toList(VM vm) {
+  return indicesToList(vm, [] (Word word) { return word; });
+}
+
+UnstableNode BitArray::complementToList(VM vm) {
+  return indicesToList(vm, [] (Word word) { return ~word; });
+}
+
+size_t BitArray::getOffset(RichNode self, VM vm, RichNode index) {
+  auto indexIntValue = getArgument<nativeint>(vm, index, "integer");
+
+  if ((indexIntValue < _low) || (indexIntValue > _high))
+    raiseKernelError(vm, "BitArray.index", self, index);
+
+  return (size_t) (indexIntValue - _low);
+}
+
+void BitArray::requireBitArray(VM vm, RichNode value) {
+  if (!value.is<BitArray>()) {
+    if (value.isTransient())
+      waitFor(vm, value);
+    raiseTypeError(vm, "BitArray", value);
+  }
+}
+
+BitArray::Word* BitArray::getOperandWords(RichNode self, VM vm,
+                                          RichNode other) {
+  requireBitArray(vm, other);
+  auto otherArray = other.as<BitArray>();
+
+  if ((otherArray.getLow() != _low) || (otherArray.getHigh() != _high))
+    raiseKernelError(vm, "BitArray.binop", self, other);
+
+  return otherArray.getElementsArray();
+}
+
+template <class WordOp>
+void BitArray::combine(RichNode self, VM vm, RichNode other, WordOp op) {
+  if (!isHomedInCurrentSpace(vm))
+    raise(vm, "globalState", "bitArray");
+
+  Word* words = getElementsArray();
+  Word* otherWords = getOperandWords(self, vm, other);
+
+  for (size_t i = 0; i < getArraySize(); i++)
+    words[i] = op(words[i], otherWords[i]);
+}
+
+template <class WordOp>
+UnstableNode BitArray::indicesToList(VM vm, WordOp op) {
+  // Walk the bits downwards so that the list is built without reversal
+  UnstableNode result = mozart::build(vm, vm->coreatoms.nil);
+
+  Word* words = getElementsArray();
+  size_t wordCount = getArraySize();
+
+  for (size_t i = wordCount; i > 0; i--) {
+    Word word = op(words[i-1]);
+    if (i == wordCount)
+      word &= lastWordMask();
+
+    while (word != 0) {
+      size_t bit = bitsPerWord - 1 - __builtin_clzll(word);
+      word &= ~((Word) 1 << bit);
+
+      nativeint index = _low + (nativeint) ((i-1) * bitsPerWord + bit);
+      result = buildCons(vm, index, std::move(result));
+    }
+  }
+
+  return result;
+}
+
+}
+
+#endif // MOZART_GENERATOR
+
+#endif // MOZART_BITARRAY_H
@@ -0,0 +1,130 @@
+// Copyright © 2014, Université catholique de Louvain
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// *  Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// *  Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MOZART_BUILTINSTATS_DECL_H
+#define MOZART_BUILTINSTATS_DECL_H
+
+#include "core-forward-decl.hh"
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace mozart {
+
+namespace builtins {
+  class BaseBuiltin;
+}
+
+//////////////////
+// BuiltinStats //
+//////////////////
+
+/**
+ * Call counters and cumulative timing of the builtins
+ * While they are enabled, BuiltinProcedure::callBuiltin() brackets each call
+ * with enter() and leave(). A builtin that raises, fails or suspends leaves
+ * through the catch clause of the emulator, which calls abort() instead, so
+ * that errors and suspensions are counted apart.
+ * When they are disabled, the only cost is a test per builtin call.
+ *
+ * Builtins that the compiler inlines as opcodes are not counted.
+ */
+class BuiltinStats {
+public:
+  struct Entry {
+    Entry(): calls(0), raised(0), suspended(0), time(0) {}
+
+    std::uint64_t calls;
+    std::uint64_t raised;    // calls that raised or failed
+    std::uint64_t suspended; // calls that waited on a variable
+    std::uint64_t time;      // cumulative, in nanoseconds
+  };
+
+  typedef std::vector<std::pair<std::string, Entry>> Report;
+
+public:
+  BuiltinStats(): _enabled(false), _current(nullptr) {}
+
+  bool isEnabled() {
+    return _enabled;
+  }
+
+  /** Reset the statistics and start collecting them */
+  void start();
+
+  void stop() {
+    _enabled = false;
+    _current = nullptr;
+  }
+
+  void enter(builtins::BaseBuiltin* builtin) {
+    _current = &_entries[builtin];
+    _current->calls++;
+    _currentStart = std::chrono::steady_clock::now();
+  }
+
+  void leave() {
+    // After a nested builtin call, the outer call is counted but not timed
+    if (_current == nullptr)
+      return;
+
+    _current->time += std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now() - _currentStart).count();
+    _current = nullptr;
+  }
+
+  void abort(bool suspended) {
+    if (_current == nullptr)
+      return;
+
+    if (suspended)
+      _current->suspended++;
+    else
+      _current->raised++;
+    leave();
+  }
+
+  /** Statistics by "Module.name", by decreasing time, then name */
+  Report getReport();
+
+  /** Write the report as a table, one builtin per line */
+  void dump(std::ostream& output);
+
+private:
+  bool _enabled;
+
+  // References to the elements of an unordered_map survive a rehash
+  std::unordered_map<builtins::BaseBuiltin*, Entry> _entries;
+  Entry* _current;
+  std::chrono::steady_clock::time_point _currentStart;
+};
+
+}
+
+#endif // MOZART_BUILTINSTATS_DECL_H
@@ -0,0 +1,81 @@
+// Copyright © 2014, Université catholique de Louvain
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// *  Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// *  Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "mozart.hh"
+
+#include <algorithm>
+#include <iomanip>
+
+namespace mozart {
+
+//////////////////
+// BuiltinStats //
+//////////////////
+
+void BuiltinStats::start() {
+  _entries.clear();
+  _current = nullptr;
+  _enabled = true;
+}
+
+BuiltinStats::Report BuiltinStats::getReport() {
+  Report result;
+
+  for (auto& entry : _entries) {
+    auto builtin = entry.first;
+    std::string name = builtin->getModuleName();
+    if (!name.empty())
+      name += ".";
+    name += builtin->getName();
+    result.emplace_back(std::move(name), entry.second);
+  }
+
+  std::sort(result.begin(), result.end(),
+    [] (const Report::value_type& left, const Report::value_type& right) {
+      if (left.second.time != right.second.time)
+        return left.second.time > right.second.time;
+      return left.first < right.first;
+    });
+
+  return result;
+}
+
+void BuiltinStats::dump(std::ostream& output) {
+  output << std::setw(14) << "time (us)" << std::setw(12) << "calls"
+         << std::setw(10) << "raised" << std::setw(10) << "suspended"
+         << std::setw(12) << "mean (ns)"
+         << "  builtin\n";
+
+  for (auto& line : getReport()) {
+    auto& entry = line.second;
+    output << std::setw(14) << entry.time / 1000
+           << std::setw(12) << entry.calls
+           << std::setw(10) << entry.raised
+           << std::setw(10) << entry.suspended
+           << std::setw(12) << (entry.calls == 0 ? 0 : entry.time / entry.calls)
+           << "  " << line.first << "\n";
+  }
+}
+
+}
@@ -48,7 +48,18 @@ public:
     return vm->getAtom("byteString");
   }
 
-  ByteString(VM vm, const LString<unsigned char>& bytes) : _bytes(bytes) {}
+  ByteString(VM vm, const LString<unsigned char>& bytes) :
+    _bytes(bytes), _storage(nullptr) {}
+
+  /**
+   * Byte string whose bytes are outside of the heap, in memory owned by
+   * storage
+   * The byte string and its copies keep storage alive, and the GC moves
+   * only the pointer to the bytes.
+   */
+  inline
+  ByteString(VM vm, const LString<unsigned char>& bytes,
+             const std::shared_ptr<const void>& storage);
 
   inline
   ByteString(VM vm, GR gr, ByteString& from);
@@ -118,7 +129,15 @@ public:
   void printReprToStream(VM vm, std::ostream& out, int depth, int width);
 
 private:
+  inline
+  void _setStorage(VM vm, const std::shared_ptr<const void>& storage);
+
   LString<unsigned char> _bytes;
+
+  // Owner of the bytes when they are outside of the heap, else nullptr.
+  // Each copy of the node holds its own reference, which is dropped by the
+  // cleanup that follows the next GC.
+  std::shared_ptr<const void>* _storage;
 };
 
 #ifndef MOZART_GENERATOR
@@ -40,8 +40,25 @@ namespace mozart {
 
 // Core methods ----------------------------------------------------------------
 
+ByteString::ByteString(VM vm, const LString<unsigned char>& bytes,
+                       const std::shared_ptr<const void>& storage)
+  : _bytes(bytes) {
+  _setStorage(vm, storage);
+}
+
 ByteString::ByteString(VM vm, GR gr, ByteString& from)
-  : _bytes(vm, from._bytes) {
+  : _bytes(from._storage == nullptr ?
+           LString<unsigned char>(vm, from._bytes) : from._bytes),
+    _storage(nullptr) {
+  if (from._storage != nullptr)
+    _setStorage(vm, *from._storage);
+}
+
+void ByteString::_setStorage(VM vm,
+                             const std::shared_ptr<const void>& storage) {
+  auto reference = new std::shared_ptr<const void>(storage);
+  _storage = reference;
+  vm->onCleanup([reference] (VM) { delete reference; });
 }
 
 bool ByteString::equals(VM vm, RichNode right) {
@@ -110,7 +127,11 @@ UnstableNode ByteString::stringSlice(RichNode self, VM vm,
   if (fromOffset < 0 || fromOffset > toOffset || toOffset > _bytes.length)
     raiseIndexOutOfBounds(vm, fromOffset, toOffset);
 
-  return ByteString::build(vm, _bytes.slice(fromOffset, toOffset));
+  auto slice = _bytes.slice(fromOffset, toOffset);
+  if (_storage != nullptr)
+    return ByteString::build(vm, slice, *_storage);
+  else
+    return ByteString::build(vm, slice);
 }
 
 void ByteString::stringSearch(
@@ -149,8 +170,7 @@ void ByteString::stringSearch(
   } else {
 
     auto needle = StringLike(needleNode).byteStringGet(vm);
-    auto foundIter = std::search(haystack.begin(), haystack.end(),
-                                 needle->begin(), needle->end());
+    auto foundIter = searchLString(haystack, *needle);
     if (foundIter == haystack.end()) {
       begin = Boolean::build(vm, false);
       end = Boolean::build(vm, false);
@@ -80,6 +80,9 @@ public:
   inline
   void getDebugInfo(VM vm, atom_t & printName, class mozart::UnstableNode & debugData);
 
+  inline
+  class mozart::StableNode * getBody();
+
   inline
   void printReprToStream(VM vm, std::ostream & out, int depth, int width);
 
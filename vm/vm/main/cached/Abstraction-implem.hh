@@ -95,6 +95,11 @@ void  TypedRichNode<Abstraction>::getDebugInfo(VM vm, atom_t & printName, class
   _self.access<Abstraction>().getDebugInfo(vm, printName, debugData);
 }
 
+inline
+class mozart::StableNode *  TypedRichNode<Abstraction>::getBody() {
+  return _self.access<Abstraction>().getBody();
+}
+
 inline
 void  TypedRichNode<Abstraction>::printReprToStream(VM vm, std::ostream & out, int depth, int width) {
   _self.access<Abstraction>().printReprToStream(vm, out, depth, width);
@@ -0,0 +1,115 @@
+template <>
+class TypeInfoOf<BitArray>: public TypeInfo {
+
+  static constexpr UUID uuid() {
+    return UUID();
+  }
+public:
+  TypeInfoOf() : TypeInfo("BitArray", uuid(), false, false, false, sbTokenEq, 0) {}
+
+  static const TypeInfoOf<BitArray>* const instance() {
+    return &RawType<BitArray>::rawType;
+  }
+
+  static Type type() {
+    return Type(instance());
+  }
+
+  atom_t getTypeAtom(VM vm) const {
+    return BitArray::getTypeAtom(vm);
+  }
+
+  inline
+  void printReprToStream(VM vm, RichNode self, std::ostream& out,
+                         int depth, int width) const;
+
+  inline
+  void gCollect(GC gc, RichNode from, StableNode& to) const;
+
+  inline
+  void gCollect(GC gc, RichNode from, UnstableNode& to) const;
+
+  inline
+  void sClone(SC sc, RichNode from, StableNode& to) const;
+
+  inline
+  void sClone(SC sc, RichNode from, UnstableNode& to) const;
+};
+
+template <>
+class TypedRichNode<BitArray>: public BaseTypedRichNode {
+public:
+  explicit TypedRichNode(RichNode self) : BaseTypedRichNode(self) {}
+
+  inline
+  size_t getArraySize();
+
+  inline
+  StaticArray<std::uint64_t> getElementsArray();
+
+  inline
+  std::uint64_t& getElements(size_t i);
+
+  inline
+  class mozart::Space * home();
+
+  inline
+  size_t getArraySizeImpl();
+
+  inline
+  nativeint getLow();
+
+  inline
+  nativeint getHigh();
+
+  inline
+  size_t getWidth();
+
+  inline
+  class mozart::UnstableNode low(VM vm);
+
+  inline
+  class mozart::UnstableNode high(VM vm);
+
+  inline
+  bool test(VM vm, class mozart::RichNode index);
+
+  inline
+  void set(VM vm, class mozart::RichNode index);
+
+  inline
+  void clear(VM vm, class mozart::RichNode index);
+
+  inline
+  class mozart::UnstableNode clone(VM vm);
+
+  inline
+  void disj(VM vm, class mozart::RichNode other);
+
+  inline
+  void conj(VM vm, class mozart::RichNode other);
+
+  inline
+  void exclDisj(VM vm, class mozart::RichNode other);
+
+  inline
+  void nimpl(VM vm, class mozart::RichNode other);
+
+  inline
+  bool disjoint(VM vm, class mozart::RichNode other);
+
+  inline
+  bool subsumes(VM vm, class mozart::RichNode other);
+
+  inline
+  size_t card(VM vm);
+
+  inline
+  class mozart::UnstableNode toList(VM vm);
+
+  inline
+  class mozart::UnstableNode complementToList(VM vm);
+
+  inline
+  void printReprToStream(VM vm, std::ostream & out, int depth, int width);
+};
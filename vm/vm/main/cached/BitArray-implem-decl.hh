@@ -0,0 +1,7 @@
+class BitArray;
+
+template <>
+class Storage<BitArray> {
+public:
+  typedef ImplWithArray<BitArray, std::uint64_t> Type;
+};
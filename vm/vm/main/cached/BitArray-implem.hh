@@ -0,0 +1,151 @@
+
+void TypeInfoOf<BitArray>::printReprToStream(VM vm, RichNode self, std::ostream& out,
+                    int depth, int width) const {
+  assert(self.is<BitArray>());
+  self.as<BitArray>().printReprToStream(vm, out, depth, width);
+}
+
+void TypeInfoOf<BitArray>::gCollect(GC gc, RichNode from, StableNode& to) const {
+  assert(from.type() == type());
+  to.make<BitArray>(gc->vm, from.as<BitArray>().getArraySize(), gc, from.access<BitArray>());
+}
+
+void TypeInfoOf<BitArray>::gCollect(GC gc, RichNode from, UnstableNode& to) const {
+  assert(from.type() == type());
+  to.make<BitArray>(gc->vm, from.as<BitArray>().getArraySize(), gc, from.access<BitArray>());
+}
+
+void TypeInfoOf<BitArray>::sClone(SC sc, RichNode from, StableNode& to) const {
+  assert(from.type() == type());
+  if (from.as<BitArray>().home()->shouldBeCloned()) {
+    to.make<BitArray>(sc->vm, from.as<BitArray>().getArraySize(), sc, from.access<BitArray>());
+  } else {
+    to.init(sc->vm, from);
+  }
+}
+
+void TypeInfoOf<BitArray>::sClone(SC sc, RichNode from, UnstableNode& to) const {
+  assert(from.type() == type());
+  if (from.as<BitArray>().home()->shouldBeCloned()) {
+    to.make<BitArray>(sc->vm, from.as<BitArray>().getArraySize(), sc, from.access<BitArray>());
+  } else {
+    to.init(sc->vm, from);
+  }
+}
+
+size_t TypedRichNode<BitArray>::getArraySize() {
+  return _self.access<BitArray>().getArraySize();
+}
+
+StaticArray<std::uint64_t> TypedRichNode<BitArray>::getElementsArray() {
+  return _self.access<BitArray>().getElementsArray();
+}
+
+std::uint64_t& TypedRichNode<BitArray>::getElements(size_t i) {
+  return _self.access<BitArray>().getElements(i);
+}
+
+inline
+class mozart::Space *  TypedRichNode<BitArray>::home() {
+  return _self.access<BitArray>().home();
+}
+
+inline
+size_t  TypedRichNode<BitArray>::getArraySizeImpl() {
+  return _self.access<BitArray>().getArraySizeImpl();
+}
+
+inline
+nativeint  TypedRichNode<BitArray>::getLow() {
+  return _self.access<BitArray>().getLow();
+}
+
+inline
+nativeint  TypedRichNode<BitArray>::getHigh() {
+  return _self.access<BitArray>().getHigh();
+}
+
+inline
+size_t  TypedRichNode<BitArray>::getWidth() {
+  return _self.access<BitArray>().getWidth();
+}
+
+inline
+class mozart::UnstableNode  TypedRichNode<BitArray>::low(VM vm) {
+  return _self.access<BitArray>().low(vm);
+}
+
+inline
+class mozart::UnstableNode  TypedRichNode<BitArray>::high(VM vm) {
+  return _self.access<BitArray>().high(vm);
+}
+
+inline
+bool  TypedRichNode<BitArray>::test(VM vm, class mozart::RichNode index) {
+  return _self.access<BitArray>().test(_self, vm, index);
+}
+
+inline
+void  TypedRichNode<BitArray>::set(VM vm, class mozart::RichNode index) {
+  _self.access<BitArray>().set(_self, vm, index);
+}
+
+inline
+void  TypedRichNode<BitArray>::clear(VM vm, class mozart::RichNode index) {
+  _self.access<BitArray>().clear(_self, vm, index);
+}
+
+inline
+class mozart::UnstableNode  TypedRichNode<BitArray>::clone(VM vm) {
+  return _self.access<BitArray>().clone(vm);
+}
+
+inline
+void  TypedRichNode<BitArray>::disj(VM vm, class mozart::RichNode other) {
+  _self.access<BitArray>().disj(_self, vm, other);
+}
+
+inline
+void  TypedRichNode<BitArray>::conj(VM vm, class mozart::RichNode other) {
+  _self.access<BitArray>().conj(_self, vm, other);
+}
+
+inline
+void  TypedRichNode<BitArray>::exclDisj(VM vm, class mozart::RichNode other) {
+  _self.access<BitArray>().exclDisj(_self, vm, other);
+}
+
+inline
+void  TypedRichNode<BitArray>::nimpl(VM vm, class mozart::RichNode other) {
+  _self.access<BitArray>().nimpl(_self, vm, other);
+}
+
+inline
+bool  TypedRichNode<BitArray>::disjoint(VM vm, class mozart::RichNode other) {
+  return _self.access<BitArray>().disjoint(_self, vm, other);
+}
+
+inline
+bool  TypedRichNode<BitArray>::subsumes(VM vm, class mozart::RichNode other) {
+  return _self.access<BitArray>().subsumes(vm, other);
+}
+
+inline
+size_t  TypedRichNode<BitArray>::card(VM vm) {
+  return _self.access<BitArray>().card(vm);
+}
+
+inline
+class mozart::UnstableNode  TypedRichNode<BitArray>::toList(VM vm) {
+  return _self.access<BitArray>().toList(vm);
+}
+
+inline
+class mozart::UnstableNode  TypedRichNode<BitArray>::complementToList(VM vm) {
+  return _self.access<BitArray>().complementToList(vm);
+}
+
+inline
+void  TypedRichNode<BitArray>::printReprToStream(VM vm, std::ostream & out, int depth, int width) {
+  _self.access<BitArray>().printReprToStream(vm, out, depth, width);
+}
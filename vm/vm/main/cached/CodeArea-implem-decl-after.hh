@@ -68,6 +68,27 @@ public:
   inline
   void getCodeAreaDebugInfo(VM vm, atom_t & printName, class mozart::UnstableNode & debugData);
 
+  inline
+  ByteCode * getCodeBlock(VM vm);
+
+  inline
+  size_t getCodeBlockSize();
+
+  inline
+  size_t getArity();
+
+  inline
+  size_t getXcount();
+
+  inline
+  atom_t getPrintName();
+
+  inline
+  class mozart::StableNode * getDebugData();
+
+  inline
+  bool isCodeBlockDecoded();
+
   inline
   void printReprToStream(VM vm, std::ostream & out, int depth, int width);
 
@@ -67,6 +67,41 @@ void  TypedRichNode<CodeArea>::getCodeAreaDebugInfo(VM vm, atom_t & printName, c
   _self.access<CodeArea>().getCodeAreaDebugInfo(vm, printName, debugData);
 }
 
+inline
+ByteCode *  TypedRichNode<CodeArea>::getCodeBlock(VM vm) {
+  return _self.access<CodeArea>().getCodeBlock(vm);
+}
+
+inline
+size_t  TypedRichNode<CodeArea>::getCodeBlockSize() {
+  return _self.access<CodeArea>().getCodeBlockSize();
+}
+
+inline
+size_t  TypedRichNode<CodeArea>::getArity() {
+  return _self.access<CodeArea>().getArity();
+}
+
+inline
+size_t  TypedRichNode<CodeArea>::getXcount() {
+  return _self.access<CodeArea>().getXcount();
+}
+
+inline
+atom_t  TypedRichNode<CodeArea>::getPrintName() {
+  return _self.access<CodeArea>().getPrintName();
+}
+
+inline
+class mozart::StableNode *  TypedRichNode<CodeArea>::getDebugData() {
+  return _self.access<CodeArea>().getDebugData();
+}
+
+inline
+bool  TypedRichNode<CodeArea>::isCodeBlockDecoded() {
+  return _self.access<CodeArea>().isCodeBlockDecoded();
+}
+
 inline
 void  TypedRichNode<CodeArea>::printReprToStream(VM vm, std::ostream & out, int depth, int width) {
   _self.access<CodeArea>().printReprToStream(vm, out, depth, width);
@@ -0,0 +1,88 @@
+template <>
+class TypeInfoOf<PersistentMap>: public TypeInfo {
+
+  static constexpr UUID uuid() {
+    return UUID();
+  }
+public:
+  TypeInfoOf() : TypeInfo("PersistentMap", uuid(), false, false, false, sbStructural, 0) {}
+
+  static const TypeInfoOf<PersistentMap>* const instance() {
+    return &RawType<PersistentMap>::rawType;
+  }
+
+  static Type type() {
+    return Type(instance());
+  }
+
+  atom_t getTypeAtom(VM vm) const {
+    return PersistentMap::getTypeAtom(vm);
+  }
+
+  inline
+  void printReprToStream(VM vm, RichNode self, std::ostream& out,
+                         int depth, int width) const;
+
+  inline
+  UnstableNode serialize(VM vm, SE s, RichNode from) const;
+
+  inline
+  void gCollect(GC gc, RichNode from, StableNode& to) const;
+
+  inline
+  void gCollect(GC gc, RichNode from, UnstableNode& to) const;
+
+  inline
+  void sClone(SC sc, RichNode from, StableNode& to) const;
+
+  inline
+  void sClone(SC sc, RichNode from, UnstableNode& to) const;
+};
+
+template <>
+class TypedRichNode<PersistentMap>: public BaseTypedRichNode {
+public:
+  explicit TypedRichNode(RichNode self) : BaseTypedRichNode(self) {}
+
+  inline
+  size_t getSize();
+
+  inline
+  bool equals(VM vm, class mozart::RichNode right, class mozart::WalkStack & stack);
+
+  inline
+  class mozart::StableNode * lookup(VM vm, class mozart::RichNode key);
+
+  inline
+  bool member(VM vm, class mozart::RichNode key);
+
+  inline
+  class mozart::UnstableNode get(VM vm, class mozart::RichNode key);
+
+  inline
+  class mozart::UnstableNode condGet(VM vm, class mozart::RichNode key, class mozart::RichNode defaultValue);
+
+  inline
+  class mozart::UnstableNode put(VM vm, class mozart::RichNode key, class mozart::RichNode value);
+
+  inline
+  class mozart::UnstableNode remove(VM vm, class mozart::RichNode key);
+
+  inline
+  class mozart::UnstableNode keys(VM vm);
+
+  inline
+  class mozart::UnstableNode items(VM vm);
+
+  inline
+  class mozart::UnstableNode entries(VM vm);
+
+  inline
+  class mozart::UnstableNode toRecord(VM vm, class mozart::RichNode label);
+
+  inline
+  class mozart::UnstableNode serialize(VM vm, SE se);
+
+  inline
+  void printReprToStream(VM vm, std::ostream & out, int depth, int width);
+};
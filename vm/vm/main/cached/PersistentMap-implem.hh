@@ -0,0 +1,100 @@
+void TypeInfoOf<PersistentMap>::printReprToStream(VM vm, RichNode self, std::ostream& out,
+                    int depth, int width) const {
+  assert(self.is<PersistentMap>());
+  self.as<PersistentMap>().printReprToStream(vm, out, depth, width);
+}
+
+UnstableNode TypeInfoOf<PersistentMap>::serialize(VM vm, SE s, RichNode from) const {
+  assert(from.is<PersistentMap>());
+  return from.as<PersistentMap>().serialize(vm, s);
+}
+
+void TypeInfoOf<PersistentMap>::gCollect(GC gc, RichNode from, StableNode& to) const {
+  assert(from.type() == type());
+  to.make<PersistentMap>(gc->vm, gc, from.access<PersistentMap>());
+}
+
+void TypeInfoOf<PersistentMap>::gCollect(GC gc, RichNode from, UnstableNode& to) const {
+  assert(from.type() == type());
+  to.make<PersistentMap>(gc->vm, gc, from.access<PersistentMap>());
+}
+
+void TypeInfoOf<PersistentMap>::sClone(SC sc, RichNode from, StableNode& to) const {
+  assert(from.type() == type());
+  to.make<PersistentMap>(sc->vm, sc, from.access<PersistentMap>());
+}
+
+void TypeInfoOf<PersistentMap>::sClone(SC sc, RichNode from, UnstableNode& to) const {
+  assert(from.type() == type());
+  to.make<PersistentMap>(sc->vm, sc, from.access<PersistentMap>());
+}
+
+inline
+size_t  TypedRichNode<PersistentMap>::getSize() {
+  return _self.access<PersistentMap>().getSize();
+}
+
+inline
+bool  TypedRichNode<PersistentMap>::equals(VM vm, class mozart::RichNode right, class mozart::WalkStack & stack) {
+  return _self.access<PersistentMap>().equals(vm, right, stack);
+}
+
+inline
+class mozart::StableNode *  TypedRichNode<PersistentMap>::lookup(VM vm, class mozart::RichNode key) {
+  return _self.access<PersistentMap>().lookup(vm, key);
+}
+
+inline
+bool  TypedRichNode<PersistentMap>::member(VM vm, class mozart::RichNode key) {
+  return _self.access<PersistentMap>().member(vm, key);
+}
+
+inline
+class mozart::UnstableNode  TypedRichNode<PersistentMap>::get(VM vm, class mozart::RichNode key) {
+  return _self.access<PersistentMap>().get(_self, vm, key);
+}
+
+inline
+class mozart::UnstableNode  TypedRichNode<PersistentMap>::condGet(VM vm, class mozart::RichNode key, class mozart::RichNode defaultValue) {
+  return _self.access<PersistentMap>().condGet(vm, key, defaultValue);
+}
+
+inline
+class mozart::UnstableNode  TypedRichNode<PersistentMap>::put(VM vm, class mozart::RichNode key, class mozart::RichNode value) {
+  return _self.access<PersistentMap>().put(vm, key, value);
+}
+
+inline
+class mozart::UnstableNode  TypedRichNode<PersistentMap>::remove(VM vm, class mozart::RichNode key) {
+  return _self.access<PersistentMap>().remove(_self, vm, key);
+}
+
+inline
+class mozart::UnstableNode  TypedRichNode<PersistentMap>::keys(VM vm) {
+  return _self.access<PersistentMap>().keys(vm);
+}
+
+inline
+class mozart::UnstableNode  TypedRichNode<PersistentMap>::items(VM vm) {
+  return _self.access<PersistentMap>().items(vm);
+}
+
+inline
+class mozart::UnstableNode  TypedRichNode<PersistentMap>::entries(VM vm) {
+  return _self.access<PersistentMap>().entries(vm);
+}
+
+inline
+class mozart::UnstableNode  TypedRichNode<PersistentMap>::toRecord(VM vm, class mozart::RichNode label) {
+  return _self.access<PersistentMap>().toRecord(vm, label);
+}
+
+inline
+class mozart::UnstableNode  TypedRichNode<PersistentMap>::serialize(VM vm, SE se) {
+  return _self.access<PersistentMap>().serialize(vm, se);
+}
+
+inline
+void  TypedRichNode<PersistentMap>::printReprToStream(VM vm, std::ostream & out, int depth, int width) {
+  _self.access<PersistentMap>().printReprToStream(vm, out, depth, width);
+}
@@ -0,0 +1,76 @@
+template <>
+class TypeInfoOf<PersistentMapNode>: public TypeInfo {
+
+  static constexpr UUID uuid() {
+    return UUID();
+  }
+public:
+  TypeInfoOf() : TypeInfo("PersistentMapNode", uuid(), false, false, false, sbTokenEq, 0) {}
+
+  static const TypeInfoOf<PersistentMapNode>* const instance() {
+    return &RawType<PersistentMapNode>::rawType;
+  }
+
+  static Type type() {
+    return Type(instance());
+  }
+
+  atom_t getTypeAtom(VM vm) const {
+    return PersistentMapNode::getTypeAtom(vm);
+  }
+
+  inline
+  void printReprToStream(VM vm, RichNode self, std::ostream& out,
+                         int depth, int width) const;
+
+  inline
+  void gCollect(GC gc, RichNode from, StableNode& to) const;
+
+  inline
+  void gCollect(GC gc, RichNode from, UnstableNode& to) const;
+
+  inline
+  void sClone(SC sc, RichNode from, StableNode& to) const;
+
+  inline
+  void sClone(SC sc, RichNode from, UnstableNode& to) const;
+};
+
+template <>
+class TypedRichNode<PersistentMapNode>: public BaseTypedRichNode {
+public:
+  explicit TypedRichNode(RichNode self) : BaseTypedRichNode(self) {}
+
+  inline
+  size_t getArraySize();
+
+  inline
+  StaticArray<class mozart::StableNode> getElementsArray();
+
+  inline
+  class mozart::StableNode& getElements(size_t i);
+
+  inline
+  size_t getArraySizeImpl();
+
+  inline
+  std::uint32_t getDataMap();
+
+  inline
+  std::uint32_t getNodeMap();
+
+  inline
+  bool isCollision();
+
+  inline
+  size_t getEntryCount();
+
+  inline
+  size_t dataIndex(std::uint32_t bit);
+
+  inline
+  size_t nodeIndex(std::uint32_t bit);
+
+  inline
+  void printReprToStream(VM vm, std::ostream & out, int depth, int width);
+};
@@ -0,0 +1,7 @@
+class PersistentMapNode;
+
+template <>
+class Storage<PersistentMapNode> {
+public:
+  typedef ImplWithArray<PersistentMapNode, class mozart::StableNode> Type;
+};
@@ -0,0 +1,77 @@
+void TypeInfoOf<PersistentMapNode>::printReprToStream(VM vm, RichNode self, std::ostream& out,
+                    int depth, int width) const {
+  assert(self.is<PersistentMapNode>());
+  self.as<PersistentMapNode>().printReprToStream(vm, out, depth, width);
+}
+
+void TypeInfoOf<PersistentMapNode>::gCollect(GC gc, RichNode from, StableNode& to) const {
+  assert(from.type() == type());
+  to.make<PersistentMapNode>(gc->vm, from.as<PersistentMapNode>().getArraySize(), gc, from.access<PersistentMapNode>());
+}
+
+void TypeInfoOf<PersistentMapNode>::gCollect(GC gc, RichNode from, UnstableNode& to) const {
+  assert(from.type() == type());
+  to.make<PersistentMapNode>(gc->vm, from.as<PersistentMapNode>().getArraySize(), gc, from.access<PersistentMapNode>());
+}
+
+void TypeInfoOf<PersistentMapNode>::sClone(SC sc, RichNode from, StableNode& to) const {
+  assert(from.type() == type());
+  to.make<PersistentMapNode>(sc->vm, from.as<PersistentMapNode>().getArraySize(), sc, from.access<PersistentMapNode>());
+}
+
+void TypeInfoOf<PersistentMapNode>::sClone(SC sc, RichNode from, UnstableNode& to) const {
+  assert(from.type() == type());
+  to.make<PersistentMapNode>(sc->vm, from.as<PersistentMapNode>().getArraySize(), sc, from.access<PersistentMapNode>());
+}
+
+size_t TypedRichNode<PersistentMapNode>::getArraySize() {
+  return _self.access<PersistentMapNode>().getArraySize();
+}
+
+StaticArray<class mozart::StableNode> TypedRichNode<PersistentMapNode>::getElementsArray() {
+  return _self.access<PersistentMapNode>().getElementsArray();
+}
+
+class mozart::StableNode& TypedRichNode<PersistentMapNode>::getElements(size_t i) {
+  return _self.access<PersistentMapNode>().getElements(i);
+}
+
+inline
+size_t  TypedRichNode<PersistentMapNode>::getArraySizeImpl() {
+  return _self.access<PersistentMapNode>().getArraySizeImpl();
+}
+
+inline
+std::uint32_t  TypedRichNode<PersistentMapNode>::getDataMap() {
+  return _self.access<PersistentMapNode>().getDataMap();
+}
+
+inline
+std::uint32_t  TypedRichNode<PersistentMapNode>::getNodeMap() {
+  return _self.access<PersistentMapNode>().getNodeMap();
+}
+
+inline
+bool  TypedRichNode<PersistentMapNode>::isCollision() {
+  return _self.access<PersistentMapNode>().isCollision();
+}
+
+inline
+size_t  TypedRichNode<PersistentMapNode>::getEntryCount() {
+  return _self.access<PersistentMapNode>().getEntryCount();
+}
+
+inline
+size_t  TypedRichNode<PersistentMapNode>::dataIndex(std::uint32_t bit) {
+  return _self.access<PersistentMapNode>().dataIndex(bit);
+}
+
+inline
+size_t  TypedRichNode<PersistentMapNode>::nodeIndex(std::uint32_t bit) {
+  return _self.access<PersistentMapNode>().nodeIndex(bit);
+}
+
+inline
+void  TypedRichNode<PersistentMapNode>::printReprToStream(VM vm, std::ostream & out, int depth, int width) {
+  _self.access<PersistentMapNode>().printReprToStream(vm, out, depth, width);
+}
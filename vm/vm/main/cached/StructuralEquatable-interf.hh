@@ -13,6 +13,8 @@ public:
       return _self.as<Record>().equals(vm, right, stack);
     } else if (_self.is<Arity>()) {
       return _self.as<Arity>().equals(vm, right, stack);
+    } else if (_self.is<PersistentMap>()) {
+      return _self.as<PersistentMap>().equals(vm, right, stack);
     } else if (_self.isTransient()) {
       waitFor(vm, _self);
       throw std::exception(); // not reachable
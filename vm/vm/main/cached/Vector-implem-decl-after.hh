@@ -0,0 +1,76 @@
+template <>
+class TypeInfoOf<Vector>: public TypeInfo {
+
+  static constexpr UUID uuid() {
+    return UUID();
+  }
+public:
+  TypeInfoOf() : TypeInfo("Vector", uuid(), false, false, false, sbTokenEq, 0) {}
+
+  static const TypeInfoOf<Vector>* const instance() {
+    return &RawType<Vector>::rawType;
+  }
+
+  static Type type() {
+    return Type(instance());
+  }
+
+  atom_t getTypeAtom(VM vm) const {
+    return Vector::getTypeAtom(vm);
+  }
+
+  inline
+  void printReprToStream(VM vm, RichNode self, std::ostream& out,
+                         int depth, int width) const;
+
+  inline
+  void gCollect(GC gc, RichNode from, StableNode& to) const;
+
+  inline
+  void gCollect(GC gc, RichNode from, UnstableNode& to) const;
+
+  inline
+  void sClone(SC sc, RichNode from, StableNode& to) const;
+
+  inline
+  void sClone(SC sc, RichNode from, UnstableNode& to) const;
+};
+
+template <>
+class TypedRichNode<Vector>: public BaseTypedRichNode {
+public:
+  explicit TypedRichNode(RichNode self) : BaseTypedRichNode(self) {}
+
+  inline
+  class mozart::Space * home();
+
+  inline
+  size_t getSize();
+
+  inline
+  size_t getCapacity();
+
+  inline
+  class mozart::UnstableNode size(VM vm);
+
+  inline
+  class mozart::UnstableNode get(VM vm, class mozart::RichNode index);
+
+  inline
+  void put(VM vm, class mozart::RichNode index, class mozart::RichNode value);
+
+  inline
+  void push(VM vm, class mozart::RichNode value);
+
+  inline
+  class mozart::UnstableNode pop(VM vm);
+
+  inline
+  class mozart::UnstableNode toTuple(VM vm, class mozart::RichNode label);
+
+  inline
+  class mozart::UnstableNode toList(VM vm);
+
+  inline
+  void printReprToStream(VM vm, std::ostream & out, int depth, int width);
+};
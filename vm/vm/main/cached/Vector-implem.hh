@@ -0,0 +1,89 @@
+
+void TypeInfoOf<Vector>::printReprToStream(VM vm, RichNode self, std::ostream& out,
+                    int depth, int width) const {
+  assert(self.is<Vector>());
+  self.as<Vector>().printReprToStream(vm, out, depth, width);
+}
+
+void TypeInfoOf<Vector>::gCollect(GC gc, RichNode from, StableNode& to) const {
+  assert(from.type() == type());
+  to.make<Vector>(gc->vm, gc, from.access<Vector>());
+}
+
+void TypeInfoOf<Vector>::gCollect(GC gc, RichNode from, UnstableNode& to) const {
+  assert(from.type() == type());
+  to.make<Vector>(gc->vm, gc, from.access<Vector>());
+}
+
+void TypeInfoOf<Vector>::sClone(SC sc, RichNode from, StableNode& to) const {
+  assert(from.type() == type());
+  if (from.as<Vector>().home()->shouldBeCloned()) {
+    to.make<Vector>(sc->vm, sc, from.access<Vector>());
+  } else {
+    to.init(sc->vm, from);
+  }
+}
+
+void TypeInfoOf<Vector>::sClone(SC sc, RichNode from, UnstableNode& to) const {
+  assert(from.type() == type());
+  if (from.as<Vector>().home()->shouldBeCloned()) {
+    to.make<Vector>(sc->vm, sc, from.access<Vector>());
+  } else {
+    to.init(sc->vm, from);
+  }
+}
+
+inline
+class mozart::Space *  TypedRichNode<Vector>::home() {
+  return _self.access<Vector>().home();
+}
+
+inline
+size_t  TypedRichNode<Vector>::getSize() {
+  return _self.access<Vector>().getSize();
+}
+
+inline
+size_t  TypedRichNode<Vector>::getCapacity() {
+  return _self.access<Vector>().getCapacity();
+}
+
+inline
+class mozart::UnstableNode  TypedRichNode<Vector>::size(VM vm) {
+  return _self.access<Vector>().size(vm);
+}
+
+inline
+class mozart::UnstableNode  TypedRichNode<Vector>::get(VM vm, class mozart::RichNode index) {
+  return _self.access<Vector>().get(_self, vm, index);
+}
+
+inline
+void  TypedRichNode<Vector>::put(VM vm, class mozart::RichNode index, class mozart::RichNode value) {
+  _self.access<Vector>().put(_self, vm, index, value);
+}
+
+inline
+void  TypedRichNode<Vector>::push(VM vm, class mozart::RichNode value) {
+  _self.access<Vector>().push(vm, value);
+}
+
+inline
+class mozart::UnstableNode  TypedRichNode<Vector>::pop(VM vm) {
+  return _self.access<Vector>().pop(_self, vm);
+}
+
+inline
+class mozart::UnstableNode  TypedRichNode<Vector>::toTuple(VM vm, class mozart::RichNode label) {
+  return _self.access<Vector>().toTuple(vm, label);
+}
+
+inline
+class mozart::UnstableNode  TypedRichNode<Vector>::toList(VM vm) {
+  return _self.access<Vector>().toList(vm);
+}
+
+inline
+void  TypedRichNode<Vector>::printReprToStream(VM vm, std::ostream & out, int depth, int width) {
+  _self.access<Vector>().printReprToStream(vm, out, depth, width);
+}
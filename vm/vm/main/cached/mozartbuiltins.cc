@@ -121,6 +121,95 @@ void registerBuiltinModVirtualString(VM vm) {
 namespace biref {
 using namespace ::mozart;
 
+class ModBitArray: public BuiltinModule {
+public:
+  ModBitArray(VM vm): BuiltinModule(vm, "BitArray") {
+    instanceNew.setModuleName("BitArray");
+    instanceIs.setModuleName("BitArray");
+    instanceTest.setModuleName("BitArray");
+    instanceSet.setModuleName("BitArray");
+    instanceClear.setModuleName("BitArray");
+    instanceLow.setModuleName("BitArray");
+    instanceHigh.setModuleName("BitArray");
+    instanceClone.setModuleName("BitArray");
+    instanceDisj.setModuleName("BitArray");
+    instanceConj.setModuleName("BitArray");
+    instanceExclDisj.setModuleName("BitArray");
+    instanceNimpl.setModuleName("BitArray");
+    instanceDisjoint.setModuleName("BitArray");
+    instanceSubsumes.setModuleName("BitArray");
+    instanceCard.setModuleName("BitArray");
+    instanceToList.setModuleName("BitArray");
+    instanceComplementToList.setModuleName("BitArray");
+
+    UnstableField fields[17];
+    fields[0].feature = build(vm, "new");
+    fields[0].value = build(vm, instanceNew);
+    fields[1].feature = build(vm, "is");
+    fields[1].value = build(vm, instanceIs);
+    fields[2].feature = build(vm, "test");
+    fields[2].value = build(vm, instanceTest);
+    fields[3].feature = build(vm, "set");
+    fields[3].value = build(vm, instanceSet);
+    fields[4].feature = build(vm, "clear");
+    fields[4].value = build(vm, instanceClear);
+    fields[5].feature = build(vm, "low");
+    fields[5].value = build(vm, instanceLow);
+    fields[6].feature = build(vm, "high");
+    fields[6].value = build(vm, instanceHigh);
+    fields[7].feature = build(vm, "clone");
+    fields[7].value = build(vm, instanceClone);
+    fields[8].feature = build(vm, "disj");
+    fields[8].value = build(vm, instanceDisj);
+    fields[9].feature = build(vm, "conj");
+    fields[9].value = build(vm, instanceConj);
+    fields[10].feature = build(vm, "exclDisj");
+    fields[10].value = build(vm, instanceExclDisj);
+    fields[11].feature = build(vm, "nimpl");
+    fields[11].value = build(vm, instanceNimpl);
+    fields[12].feature = build(vm, "disjoint");
+    fields[12].value = build(vm, instanceDisjoint);
+    fields[13].feature = build(vm, "subsumes");
+    fields[13].value = build(vm, instanceSubsumes);
+    fields[14].feature = build(vm, "card");
+    fields[14].value = build(vm, instanceCard);
+    fields[15].feature = build(vm, "toList");
+    fields[15].value = build(vm, instanceToList);
+    fields[16].feature = build(vm, "complementToList");
+    fields[16].value = build(vm, instanceComplementToList);
+    UnstableNode label = build(vm, "export");
+    UnstableNode module = buildRecordDynamic(vm, label, 17, fields);
+    initModule(vm, std::move(module));
+  }
+private:
+  mozart::builtins::ModBitArray::New instanceNew;
+  mozart::builtins::ModBitArray::Is instanceIs;
+  mozart::builtins::ModBitArray::Test instanceTest;
+  mozart::builtins::ModBitArray::Set instanceSet;
+  mozart::builtins::ModBitArray::Clear instanceClear;
+  mozart::builtins::ModBitArray::Low instanceLow;
+  mozart::builtins::ModBitArray::High instanceHigh;
+  mozart::builtins::ModBitArray::Clone instanceClone;
+  mozart::builtins::ModBitArray::Disj instanceDisj;
+  mozart::builtins::ModBitArray::Conj instanceConj;
+  mozart::builtins::ModBitArray::ExclDisj instanceExclDisj;
+  mozart::builtins::ModBitArray::Nimpl instanceNimpl;
+  mozart::builtins::ModBitArray::Disjoint instanceDisjoint;
+  mozart::builtins::ModBitArray::Subsumes instanceSubsumes;
+  mozart::builtins::ModBitArray::Card instanceCard;
+  mozart::builtins::ModBitArray::ToList instanceToList;
+  mozart::builtins::ModBitArray::ComplementToList instanceComplementToList;
+};
+void registerBuiltinModBitArray(VM vm) {
+  auto module = std::make_shared<ModBitArray>(vm);
+  vm->registerBuiltinModule(module);
+}
+
+}
+
+namespace biref {
+using namespace ::mozart;
+
 class ModBoot: public BuiltinModule {
 public:
   ModBoot(VM vm): BuiltinModule(vm, "Boot") {
@@ -311,10 +400,11 @@ public:
     instanceAppend.setModuleName("CompactString");
     instanceSlice.setModuleName("CompactString");
     instanceSearch.setModuleName("CompactString");
+    instanceSearchAny.setModuleName("CompactString");
     instanceHasPrefix.setModuleName("CompactString");
     instanceHasSuffix.setModuleName("CompactString");
 
-    UnstableField fields[8];
+    UnstableField fields[9];
     fields[0].feature = build(vm, "isCompactString");
     fields[0].value = build(vm, instanceIsCompactString);
     fields[1].feature = build(vm, "isCompactByteString");
@@ -327,12 +417,14 @@ public:
     fields[4].value = build(vm, instanceSlice);
     fields[5].feature = build(vm, "search");
     fields[5].value = build(vm, instanceSearch);
-    fields[6].feature = build(vm, "hasPrefix");
-    fields[6].value = build(vm, instanceHasPrefix);
-    fields[7].feature = build(vm, "hasSuffix");
-    fields[7].value = build(vm, instanceHasSuffix);
+    fields[6].feature = build(vm, "searchAny");
+    fields[6].value = build(vm, instanceSearchAny);
+    fields[7].feature = build(vm, "hasPrefix");
+    fields[7].value = build(vm, instanceHasPrefix);
+    fields[8].feature = build(vm, "hasSuffix");
+    fields[8].value = build(vm, instanceHasSuffix);
     UnstableNode label = build(vm, "export");
-    UnstableNode module = buildRecordDynamic(vm, label, 8, fields);
+    UnstableNode module = buildRecordDynamic(vm, label, 9, fields);
     initModule(vm, std::move(module));
   }
 private:
@@ -342,6 +434,7 @@ private:
   mozart::builtins::ModCompactString::Append instanceAppend;
   mozart::builtins::ModCompactString::Slice instanceSlice;
   mozart::builtins::ModCompactString::Search instanceSearch;
+  mozart::builtins::ModCompactString::SearchAny instanceSearchAny;
   mozart::builtins::ModCompactString::HasPrefix instanceHasPrefix;
   mozart::builtins::ModCompactString::HasSuffix instanceHasSuffix;
 };
@@ -983,31 +1076,108 @@ void registerBuiltinModObject(VM vm) {
 namespace biref {
 using namespace ::mozart;
 
+class ModPersistentMap: public BuiltinModule {
+public:
+  ModPersistentMap(VM vm): BuiltinModule(vm, "PersistentMap") {
+    instanceNew.setModuleName("PersistentMap");
+    instanceIs.setModuleName("PersistentMap");
+    instanceSize.setModuleName("PersistentMap");
+    instanceMember.setModuleName("PersistentMap");
+    instanceGet.setModuleName("PersistentMap");
+    instanceCondGet.setModuleName("PersistentMap");
+    instancePut.setModuleName("PersistentMap");
+    instanceRemove.setModuleName("PersistentMap");
+    instanceKeys.setModuleName("PersistentMap");
+    instanceItems.setModuleName("PersistentMap");
+    instanceEntries.setModuleName("PersistentMap");
+    instanceToRecord.setModuleName("PersistentMap");
+
+    UnstableField fields[12];
+    fields[0].feature = build(vm, "new");
+    fields[0].value = build(vm, instanceNew);
+    fields[1].feature = build(vm, "is");
+    fields[1].value = build(vm, instanceIs);
+    fields[2].feature = build(vm, "size");
+    fields[2].value = build(vm, instanceSize);
+    fields[3].feature = build(vm, "member");
+    fields[3].value = build(vm, instanceMember);
+    fields[4].feature = build(vm, "get");
+    fields[4].value = build(vm, instanceGet);
+    fields[5].feature = build(vm, "condGet");
+    fields[5].value = build(vm, instanceCondGet);
+    fields[6].feature = build(vm, "put");
+    fields[6].value = build(vm, instancePut);
+    fields[7].feature = build(vm, "remove");
+    fields[7].value = build(vm, instanceRemove);
+    fields[8].feature = build(vm, "keys");
+    fields[8].value = build(vm, instanceKeys);
+    fields[9].feature = build(vm, "items");
+    fields[9].value = build(vm, instanceItems);
+    fields[10].feature = build(vm, "entries");
+    fields[10].value = build(vm, instanceEntries);
+    fields[11].feature = build(vm, "toRecord");
+    fields[11].value = build(vm, instanceToRecord);
+    UnstableNode label = build(vm, "export");
+    UnstableNode module = buildRecordDynamic(vm, label, 12, fields);
+    initModule(vm, std::move(module));
+  }
+private:
+  mozart::builtins::ModPersistentMap::New instanceNew;
+  mozart::builtins::ModPersistentMap::Is instanceIs;
+  mozart::builtins::ModPersistentMap::Size instanceSize;
+  mozart::builtins::ModPersistentMap::Member instanceMember;
+  mozart::builtins::ModPersistentMap::Get instanceGet;
+  mozart::builtins::ModPersistentMap::CondGet instanceCondGet;
+  mozart::builtins::ModPersistentMap::Put instancePut;
+  mozart::builtins::ModPersistentMap::Remove instanceRemove;
+  mozart::builtins::ModPersistentMap::Keys instanceKeys;
+  mozart::builtins::ModPersistentMap::Items instanceItems;
+  mozart::builtins::ModPersistentMap::Entries instanceEntries;
+  mozart::builtins::ModPersistentMap::ToRecord instanceToRecord;
+};
+void registerBuiltinModPersistentMap(VM vm) {
+  auto module = std::make_shared<ModPersistentMap>(vm);
+  vm->registerBuiltinModule(module);
+}
+
+}
+
+namespace biref {
+using namespace ::mozart;
+
 class ModPickle: public BuiltinModule {
 public:
   ModPickle(VM vm): BuiltinModule(vm, "Pickle") {
     instancePack.setModuleName("Pickle");
+    instancePackWithOptions.setModuleName("Pickle");
     instanceUnpack.setModuleName("Pickle");
     instanceSave.setModuleName("Pickle");
+    instanceSaveWithOptions.setModuleName("Pickle");
     instanceLoad.setModuleName("Pickle");
 
-    UnstableField fields[4];
+    UnstableField fields[6];
     fields[0].feature = build(vm, "pack");
     fields[0].value = build(vm, instancePack);
-    fields[1].feature = build(vm, "unpack");
-    fields[1].value = build(vm, instanceUnpack);
-    fields[2].feature = build(vm, "save");
-    fields[2].value = build(vm, instanceSave);
-    fields[3].feature = build(vm, "load");
-    fields[3].value = build(vm, instanceLoad);
+    fields[1].feature = build(vm, "packWithOptions");
+    fields[1].value = build(vm, instancePackWithOptions);
+    fields[2].feature = build(vm, "unpack");
+    fields[2].value = build(vm, instanceUnpack);
+    fields[3].feature = build(vm, "save");
+    fields[3].value = build(vm, instanceSave);
+    fields[4].feature = build(vm, "saveWithOptions");
+    fields[4].value = build(vm, instanceSaveWithOptions);
+    fields[5].feature = build(vm, "load");
+    fields[5].value = build(vm, instanceLoad);
     UnstableNode label = build(vm, "export");
-    UnstableNode module = buildRecordDynamic(vm, label, 4, fields);
+    UnstableNode module = buildRecordDynamic(vm, label, 6, fields);
     initModule(vm, std::move(module));
   }
 private:
   mozart::builtins::ModPickle::Pack instancePack;
+  mozart::builtins::ModPickle::PackWithOptions instancePackWithOptions;
   mozart::builtins::ModPickle::Unpack instanceUnpack;
   mozart::builtins::ModPickle::Save instanceSave;
+  mozart::builtins::ModPickle::SaveWithOptions instanceSaveWithOptions;
   mozart::builtins::ModPickle::Load instanceLoad;
 };
 void registerBuiltinModPickle(VM vm) {
@@ -1090,6 +1260,127 @@ void registerBuiltinModProcedure(VM vm) {
 namespace biref {
 using namespace ::mozart;
 
+class ModProfile: public BuiltinModule {
+public:
+  ModProfile(VM vm): BuiltinModule(vm, "Profile") {
+    instanceStart.setModuleName("Profile");
+    instanceStop.setModuleName("Profile");
+    instanceIsRunning.setModuleName("Profile");
+    instanceGetSampleCount.setModuleName("Profile");
+    instanceGetCollapsedStacks.setModuleName("Profile");
+    instanceGetProcedures.setModuleName("Profile");
+    instanceIsCountingOpcodes.setModuleName("Profile");
+    instanceGetOpcodeCounts.setModuleName("Profile");
+    instanceGetOpcodePairCounts.setModuleName("Profile");
+    instanceResetOpcodeCounts.setModuleName("Profile");
+    instanceSaveOpcodeCounts.setModuleName("Profile");
+    instanceGetHeapCensus.setModuleName("Profile");
+    instanceSaveHeapCensus.setModuleName("Profile");
+    instanceStartAllocations.setModuleName("Profile");
+    instanceStopAllocations.setModuleName("Profile");
+    instanceGetAllocationSampleCount.setModuleName("Profile");
+    instanceGetAllocationProfile.setModuleName("Profile");
+    instanceSaveAllocationProfile.setModuleName("Profile");
+    instanceStartTrace.setModuleName("Profile");
+    instanceStopTrace.setModuleName("Profile");
+    instanceSaveTrace.setModuleName("Profile");
+    instanceStartBuiltinStats.setModuleName("Profile");
+    instanceStopBuiltinStats.setModuleName("Profile");
+    instanceGetBuiltinStats.setModuleName("Profile");
+    instanceSaveBuiltinStats.setModuleName("Profile");
+
+    UnstableField fields[25];
+    fields[0].feature = build(vm, "start");
+    fields[0].value = build(vm, instanceStart);
+    fields[1].feature = build(vm, "stop");
+    fields[1].value = build(vm, instanceStop);
+    fields[2].feature = build(vm, "isRunning");
+    fields[2].value = build(vm, instanceIsRunning);
+    fields[3].feature = build(vm, "getSampleCount");
+    fields[3].value = build(vm, instanceGetSampleCount);
+    fields[4].feature = build(vm, "getCollapsedStacks");
+    fields[4].value = build(vm, instanceGetCollapsedStacks);
+    fields[5].feature = build(vm, "getProcedures");
+    fields[5].value = build(vm, instanceGetProcedures);
+    fields[6].feature = build(vm, "isCountingOpcodes");
+    fields[6].value = build(vm, instanceIsCountingOpcodes);
+    fields[7].feature = build(vm, "getOpcodeCounts");
+    fields[7].value = build(vm, instanceGetOpcodeCounts);
+    fields[8].feature = build(vm, "getOpcodePairCounts");
+    fields[8].value = build(vm, instanceGetOpcodePairCounts);
+    fields[9].feature = build(vm, "resetOpcodeCounts");
+    fields[9].value = build(vm, instanceResetOpcodeCounts);
+    fields[10].feature = build(vm, "saveOpcodeCounts");
+    fields[10].value = build(vm, instanceSaveOpcodeCounts);
+    fields[11].feature = build(vm, "getHeapCensus");
+    fields[11].value = build(vm, instanceGetHeapCensus);
+    fields[12].feature = build(vm, "saveHeapCensus");
+    fields[12].value = build(vm, instanceSaveHeapCensus);
+    fields[13].feature = build(vm, "startAllocations");
+    fields[13].value = build(vm, instanceStartAllocations);
+    fields[14].feature = build(vm, "stopAllocations");
+    fields[14].value = build(vm, instanceStopAllocations);
+    fields[15].feature = build(vm, "getAllocationSampleCount");
+    fields[15].value = build(vm, instanceGetAllocationSampleCount);
+    fields[16].feature = build(vm, "getAllocationProfile");
+    fields[16].value = build(vm, instanceGetAllocationProfile);
+    fields[17].feature = build(vm, "saveAllocationProfile");
+    fields[17].value = build(vm, instanceSaveAllocationProfile);
+    fields[18].feature = build(vm, "startTrace");
+    fields[18].value = build(vm, instanceStartTrace);
+    fields[19].feature = build(vm, "stopTrace");
+    fields[19].value = build(vm, instanceStopTrace);
+    fields[20].feature = build(vm, "saveTrace");
+    fields[20].value = build(vm, instanceSaveTrace);
+    fields[21].feature = build(vm, "startBuiltinStats");
+    fields[21].value = build(vm, instanceStartBuiltinStats);
+    fields[22].feature = build(vm, "stopBuiltinStats");
+    fields[22].value = build(vm, instanceStopBuiltinStats);
+    fields[23].feature = build(vm, "getBuiltinStats");
+    fields[23].value = build(vm, instanceGetBuiltinStats);
+    fields[24].feature = build(vm, "saveBuiltinStats");
+    fields[24].value = build(vm, instanceSaveBuiltinStats);
+    UnstableNode label = build(vm, "export");
+    UnstableNode module = buildRecordDynamic(vm, label, 25, fields);
+    initModule(vm, std::move(module));
+  }
+private:
+  mozart::builtins::ModProfile::Start instanceStart;
+  mozart::builtins::ModProfile::Stop instanceStop;
+  mozart::builtins::ModProfile::IsRunning instanceIsRunning;
+  mozart::builtins::ModProfile::GetSampleCount instanceGetSampleCount;
+  mozart::builtins::ModProfile::GetCollapsedStacks instanceGetCollapsedStacks;
+  mozart::builtins::ModProfile::GetProcedures instanceGetProcedures;
+  mozart::builtins::ModProfile::IsCountingOpcodes instanceIsCountingOpcodes;
+  mozart::builtins::ModProfile::GetOpcodeCounts instanceGetOpcodeCounts;
+  mozart::builtins::ModProfile::GetOpcodePairCounts instanceGetOpcodePairCounts;
+  mozart::builtins::ModProfile::ResetOpcodeCounts instanceResetOpcodeCounts;
+  mozart::builtins::ModProfile::SaveOpcodeCounts instanceSaveOpcodeCounts;
+  mozart::builtins::ModProfile::GetHeapCensus instanceGetHeapCensus;
+  mozart::builtins::ModProfile::SaveHeapCensus instanceSaveHeapCensus;
+  mozart::builtins::ModProfile::StartAllocations instanceStartAllocations;
+  mozart::builtins::ModProfile::StopAllocations instanceStopAllocations;
+  mozart::builtins::ModProfile::GetAllocationSampleCount instanceGetAllocationSampleCount;
+  mozart::builtins::ModProfile::GetAllocationProfile instanceGetAllocationProfile;
+  mozart::builtins::ModProfile::SaveAllocationProfile instanceSaveAllocationProfile;
+  mozart::builtins::ModProfile::StartTrace instanceStartTrace;
+  mozart::builtins::ModProfile::StopTrace instanceStopTrace;
+  mozart::builtins::ModProfile::SaveTrace instanceSaveTrace;
+  mozart::builtins::ModProfile::StartBuiltinStats instanceStartBuiltinStats;
+  mozart::builtins::ModProfile::StopBuiltinStats instanceStopBuiltinStats;
+  mozart::builtins::ModProfile::GetBuiltinStats instanceGetBuiltinStats;
+  mozart::builtins::ModProfile::SaveBuiltinStats instanceSaveBuiltinStats;
+};
+void registerBuiltinModProfile(VM vm) {
+  auto module = std::make_shared<ModProfile>(vm);
+  vm->registerBuiltinModule(module);
+}
+
+}
+
+namespace biref {
+using namespace ::mozart;
+
 class ModProperty: public BuiltinModule {
 public:
   ModProperty(VM vm): BuiltinModule(vm, "Property") {
@@ -1644,6 +1935,63 @@ void registerBuiltinModValue(VM vm) {
 namespace biref {
 using namespace ::mozart;
 
+class ModVector: public BuiltinModule {
+public:
+  ModVector(VM vm): BuiltinModule(vm, "Vector") {
+    instanceNew.setModuleName("Vector");
+    instanceIs.setModuleName("Vector");
+    instanceSize.setModuleName("Vector");
+    instanceGet.setModuleName("Vector");
+    instancePut.setModuleName("Vector");
+    instancePush.setModuleName("Vector");
+    instancePop.setModuleName("Vector");
+    instanceToTuple.setModuleName("Vector");
+    instanceToList.setModuleName("Vector");
+
+    UnstableField fields[9];
+    fields[0].feature = build(vm, "new");
+    fields[0].value = build(vm, instanceNew);
+    fields[1].feature = build(vm, "is");
+    fields[1].value = build(vm, instanceIs);
+    fields[2].feature = build(vm, "size");
+    fields[2].value = build(vm, instanceSize);
+    fields[3].feature = build(vm, "get");
+    fields[3].value = build(vm, instanceGet);
+    fields[4].feature = build(vm, "put");
+    fields[4].value = build(vm, instancePut);
+    fields[5].feature = build(vm, "push");
+    fields[5].value = build(vm, instancePush);
+    fields[6].feature = build(vm, "pop");
+    fields[6].value = build(vm, instancePop);
+    fields[7].feature = build(vm, "toTuple");
+    fields[7].value = build(vm, instanceToTuple);
+    fields[8].feature = build(vm, "toList");
+    fields[8].value = build(vm, instanceToList);
+    UnstableNode label = build(vm, "export");
+    UnstableNode module = buildRecordDynamic(vm, label, 9, fields);
+    initModule(vm, std::move(module));
+  }
+private:
+  mozart::builtins::ModVector::New instanceNew;
+  mozart::builtins::ModVector::Is instanceIs;
+  mozart::builtins::ModVector::Size instanceSize;
+  mozart::builtins::ModVector::Get instanceGet;
+  mozart::builtins::ModVector::Put instancePut;
+  mozart::builtins::ModVector::Push instancePush;
+  mozart::builtins::ModVector::Pop instancePop;
+  mozart::builtins::ModVector::ToTuple instanceToTuple;
+  mozart::builtins::ModVector::ToList instanceToList;
+};
+void registerBuiltinModVector(VM vm) {
+  auto module = std::make_shared<ModVector>(vm);
+  vm->registerBuiltinModule(module);
+}
+
+}
+
+namespace biref {
+using namespace ::mozart;
+
 class ModVirtualByteString: public BuiltinModule {
 public:
   ModVirtualByteString(VM vm): BuiltinModule(vm, "VirtualByteString") {
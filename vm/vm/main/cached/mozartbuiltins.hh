@@ -19,6 +19,12 @@ void registerBuiltinModVirtualString(::mozart::VM vm);
 
 namespace biref {
 
+void registerBuiltinModBitArray(::mozart::VM vm);
+
+}
+
+namespace biref {
+
 void registerBuiltinModBoot(::mozart::VM vm);
 
 }
@@ -127,6 +133,12 @@ void registerBuiltinModObject(::mozart::VM vm);
 
 namespace biref {
 
+void registerBuiltinModPersistentMap(::mozart::VM vm);
+
+}
+
+namespace biref {
+
 void registerBuiltinModPickle(::mozart::VM vm);
 
 }
@@ -145,6 +157,12 @@ void registerBuiltinModProcedure(::mozart::VM vm);
 
 namespace biref {
 
+void registerBuiltinModProfile(::mozart::VM vm);
+
+}
+
+namespace biref {
+
 void registerBuiltinModProperty(::mozart::VM vm);
 
 }
@@ -205,6 +223,12 @@ void registerBuiltinModValue(::mozart::VM vm);
 
 namespace biref {
 
+void registerBuiltinModVector(::mozart::VM vm);
+
+}
+
+namespace biref {
+
 void registerBuiltinModVirtualByteString(::mozart::VM vm);
 
 }
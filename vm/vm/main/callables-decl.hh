@@ -216,6 +216,13 @@ public:
   inline
   void getDebugInfo(VM vm, atom_t& printName, UnstableNode& debugData);
 
+public:
+  // Direct access, used by the pickler
+
+  StableNode* getBody() {
+    return &_body;
+  }
+
 public:
   // Miscellaneous
 
@@ -52,12 +52,30 @@ atom_t BuiltinProcedure::getPrintName(VM vm) {
 
 void BuiltinProcedure::callBuiltin(VM vm, size_t argc, UnstableNode* args[]) {
   assert(argc == getArity());
+
+  auto& stats = vm->getBuiltinStats();
+  if (stats.isEnabled()) {
+    stats.enter(_builtin);
+    _builtin->callBuiltin(vm, args);
+    stats.leave();
+    return;
+  }
+
   return _builtin->callBuiltin(vm, args);
 }
 
 template <class... Args>
 void BuiltinProcedure::callBuiltin(VM vm, Args&&... args) {
   assert(sizeof...(args) == getArity());
+
+  auto& stats = vm->getBuiltinStats();
+  if (stats.isEnabled()) {
+    stats.enter(_builtin);
+    _builtin->callBuiltin(vm, std::forward<Args>(args)...);
+    stats.leave();
+    return;
+  }
+
   return _builtin->callBuiltin(vm, std::forward<Args>(args)...);
 }
 
@@ -51,6 +51,20 @@ public:
   CodeArea(VM vm, size_t Kc, ByteCode* codeBlock, size_t size, size_t arity,
            size_t Xcount, atom_t printName, RichNode debugData);
 
+  /**
+   * Code area of a procedure unpickled lazily, whose byte-code is decoded
+   * from the pickle only when it is first needed, and may then be shared by
+   * all the VMs of the process.
+   * The code area and its copies keep pickleOwner, which owns the memory of
+   * pickledCodeBlock, alive until the byte-code is decoded, and then keep
+   * the shared byte-code alive.
+   */
+  inline
+  CodeArea(VM vm, size_t Kc, const UUID& uuid,
+           const unsigned char* pickledCodeBlock,
+           const std::shared_ptr<const void>& pickleOwner, size_t size,
+           size_t arity, size_t Xcount, atom_t printName, RichNode debugData);
+
   inline
   CodeArea(VM vm, size_t Kc, GR gr, CodeArea& from);
 
@@ -75,6 +89,39 @@ public:
   inline
   void getCodeAreaDebugInfo(VM vm, atom_t& printName, UnstableNode& debugData);
 
+public:
+  // Direct access, used by the pickler
+
+  ByteCode* getCodeBlock(VM vm) {
+    if (_codeBlock == nullptr)
+      decodePickledCodeBlock(vm);
+    return _codeBlock;
+  }
+
+  size_t getCodeBlockSize() {
+    return _size;
+  }
+
+  size_t getArity() {
+    return _arity;
+  }
+
+  size_t getXcount() {
+    return _Xcount;
+  }
+
+  atom_t getPrintName() {
+    return _printName;
+  }
+
+  StableNode* getDebugData() {
+    return &_debugData;
+  }
+
+  bool isCodeBlockDecoded() {
+    return _codeBlock != nullptr;
+  }
+
 public:
   // Miscellaneous
 
@@ -95,12 +142,34 @@ private:
   void _setCodeBlock(VM vm, ByteCode* codeBlock, size_t size) {
     _codeBlock = new (vm) ByteCode[size / sizeof(ByteCode)];
     std::memcpy(_codeBlock, codeBlock, size);
+    _sharedCodeBlock = false;
+    _blockOwner = nullptr;
   }
 
+  inline
+  void _setMaybeSharedCodeBlock(VM vm, const UUID& uuid, ByteCode* codeBlock,
+                                size_t size);
+
+  inline
+  void _setBlockOwner(VM vm, const std::shared_ptr<const void>& owner);
+
+  __attribute__((noinline))
+  inline
+  void decodePickledCodeBlock(VM vm);
+
   GlobalNode* _gnode;
 
   ByteCode* _codeBlock; // actual byte-code in this code area
   size_t _size;         // size of the codeBlock
+  bool _sharedCodeBlock; // codeBlock is outside of the heap, never moved
+
+  // when codeBlock is null, big-endian byte-code still to be decoded
+  const unsigned char* _pickledCodeBlock;
+  // owner of pickledCodeBlock while it is not decoded, or of codeBlock when
+  // it is shared, else nullptr.
+  // Each copy of the node holds its own reference, which is dropped by the
+  // cleanup that follows the next GC.
+  std::shared_ptr<const void>* _blockOwner;
 
   size_t _arity;  // arity of this area (number of input registers)
   size_t _Xcount; // number of X registers used in this area
@@ -41,8 +41,8 @@ CodeArea::CodeArea(
   VM vm, size_t Kc, ByteCode* codeBlock, size_t size, size_t arity,
   size_t Xcount, atom_t printName, RichNode debugData)
 
-  : _gnode(nullptr), _size(size), _arity(arity), _Xcount(Xcount), _Kc(Kc),
-    _printName(printName) {
+  : _gnode(nullptr), _size(size), _blockOwner(nullptr), _arity(arity),
+    _Xcount(Xcount), _Kc(Kc), _printName(printName) {
 
   _setCodeBlock(vm, codeBlock, size);
 
@@ -54,6 +54,23 @@ CodeArea::CodeArea(
     getElements(i).init(vm);
 }
 
+CodeArea::CodeArea(
+  VM vm, size_t Kc, const UUID& uuid, const unsigned char* pickledCodeBlock,
+  const std::shared_ptr<const void>& pickleOwner, size_t size, size_t arity,
+  size_t Xcount, atom_t printName, RichNode debugData)
+
+  : _gnode(nullptr), _codeBlock(nullptr), _size(size),
+    _sharedCodeBlock(false), _pickledCodeBlock(pickledCodeBlock),
+    _arity(arity), _Xcount(Xcount), _Kc(Kc), _printName(printName) {
+
+  _setBlockOwner(vm, pickleOwner);
+
+  _debugData.init(vm, debugData);
+
+  for (size_t i = 0; i < Kc; i++)
+    getElements(i).init(vm);
+}
+
 CodeArea::CodeArea(VM vm, size_t Kc, GR gr, CodeArea& from) {
   gr->copyGNode(_gnode, from._gnode);
 
@@ -61,8 +78,20 @@ CodeArea::CodeArea(VM vm, size_t Kc, GR gr, CodeArea& from) {
   _arity = from._arity;
   _Xcount = from._Xcount;
   _Kc = Kc;
-
-  _setCodeBlock(vm, from._codeBlock, _size);
+  _blockOwner = nullptr;
+
+  if (from._codeBlock == nullptr) {
+    _codeBlock = nullptr;
+    _sharedCodeBlock = false;
+    _pickledCodeBlock = from._pickledCodeBlock;
+    _setBlockOwner(vm, *from._blockOwner);
+  } else if (from._sharedCodeBlock) {
+    _codeBlock = from._codeBlock;
+    _sharedCodeBlock = true;
+    _setBlockOwner(vm, *from._blockOwner);
+  } else {
+    _setCodeBlock(vm, from._codeBlock, _size);
+  }
 
   _printName = gr->copyAtom(from._printName);
   gr->copyStableNode(_debugData, from._debugData);
@@ -75,7 +104,7 @@ void CodeArea::getCodeAreaInfo(
   StaticArray<StableNode>& Ks) {
 
   arity = _arity;
-  start = _codeBlock;
+  start = getCodeBlock(vm);
   Xcount = _Xcount;
   Ks = getElementsArray();
 }
@@ -100,7 +129,7 @@ void CodeArea::printReprToStream(VM vm, std::ostream& out,
 UnstableNode CodeArea::serialize(VM vm, SE se) {
   UnstableNode codeAtom = mozart::build(vm, "code");
   UnstableNode block = buildTupleDynamic(
-    vm, codeAtom, _size / sizeof(ByteCode), _codeBlock,
+    vm, codeAtom, _size / sizeof(ByteCode), getCodeBlock(vm),
     [=](ByteCode b) {
       return mozart::build(vm, (nativeint) b);
     });
@@ -129,6 +158,46 @@ GlobalNode* CodeArea::globalize(RichNode self, VM vm) {
   return _gnode;
 }
 
+void CodeArea::_setMaybeSharedCodeBlock(VM vm, const UUID& uuid,
+                                        ByteCode* codeBlock, size_t size) {
+  auto shared = vm->getEnvironment().getSharedCodeBlock(
+    uuid, codeBlock, size);
+  if (shared != nullptr) {
+    // Shared byte-code is never written to
+    _codeBlock = const_cast<ByteCode*>(shared->data());
+    _sharedCodeBlock = true;
+    _setBlockOwner(vm, shared);
+  } else {
+    _setCodeBlock(vm, codeBlock, size);
+  }
+}
+
+void CodeArea::_setBlockOwner(VM vm,
+                              const std::shared_ptr<const void>& owner) {
+  auto reference = new std::shared_ptr<const void>(owner);
+  _blockOwner = reference;
+  vm->onCleanup([reference] (VM) { delete reference; });
+}
+
+void CodeArea::decodePickledCodeBlock(VM vm) {
+  size_t count = _size / sizeof(ByteCode);
+  std::vector<ByteCode> codeBlock(count);
+  for (size_t i = 0; i < count; ++i) {
+    codeBlock[i] = ((ByteCode) _pickledCodeBlock[i*2] << 8) |
+      (ByteCode) _pickledCodeBlock[i*2+1];
+  }
+
+  // The pickle is not needed any more; the cleanup deletes the reference
+  _blockOwner->reset();
+  _blockOwner = nullptr;
+  _pickledCodeBlock = nullptr;
+
+  if (_gnode != nullptr)
+    _setMaybeSharedCodeBlock(vm, _gnode->uuid, codeBlock.data(), _size);
+  else
+    _setCodeBlock(vm, codeBlock.data(), _size);
+}
+
 void CodeArea::setUUID(RichNode self, VM vm, const UUID& uuid) {
   assert(_gnode == nullptr);
   _gnode = GlobalNode::make(vm, uuid, self, "immval");
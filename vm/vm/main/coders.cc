@@ -24,8 +24,162 @@
 
 #include "mozart.hh"
 
+#ifdef MOZART_X86_SIMD_KERNELS
+#include <immintrin.h>
+#endif
+
 namespace mozart {
 
+/////////////////////////////////////
+// Bulk UTF-8 kernels (see utf.hh) //
+/////////////////////////////////////
+
+namespace internal {
+
+namespace {
+  nativeint asciiPrefixLengthScalar(const char* utf, nativeint length) {
+    const std::uint64_t highBits = 0x8080808080808080ULL;
+
+    nativeint i = 0;
+    for (; i + 8 <= length; i += 8) {
+      std::uint64_t word;
+      std::memcpy(&word, utf + i, 8);
+      if ((word & highBits) != 0)
+        break;
+    }
+    while (i < length && (unsigned char) utf[i] < 0x80)
+      ++i;
+    return i;
+  }
+
+  template <class C>
+  void widenASCIIScalar(const char* utf, nativeint length, C* dest) {
+    for (nativeint i = 0; i < length; ++i)
+      dest[i] = (C) utf[i];
+  }
+
+#ifdef MOZART_X86_SIMD_KERNELS
+
+  __attribute__((target("sse2")))
+  nativeint asciiPrefixLengthSSE2(const char* utf, nativeint length) {
+    nativeint i = 0;
+    for (; i + 16 <= length; i += 16) {
+      __m128i chunk = _mm_loadu_si128((const __m128i*) (utf + i));
+      unsigned int mask = (unsigned int) _mm_movemask_epi8(chunk);
+      if (mask != 0)
+        return i + __builtin_ctz(mask);
+    }
+    return i + asciiPrefixLengthScalar(utf + i, length - i);
+  }
+
+  __attribute__((target("avx2")))
+  nativeint asciiPrefixLengthAVX2(const char* utf, nativeint length) {
+    nativeint i = 0;
+    for (; i + 32 <= length; i += 32) {
+      __m256i chunk = _mm256_loadu_si256((const __m256i*) (utf + i));
+      unsigned int mask = (unsigned int) _mm256_movemask_epi8(chunk);
+      if (mask != 0)
+        return i + __builtin_ctz(mask);
+    }
+    return i + asciiPrefixLengthSSE2(utf + i, length - i);
+  }
+
+  __attribute__((target("sse2")))
+  void widenASCIISSE2(const char* utf, nativeint length, char16_t* dest) {
+    const __m128i zero = _mm_setzero_si128();
+    nativeint i = 0;
+    for (; i + 16 <= length; i += 16) {
+      __m128i chunk = _mm_loadu_si128((const __m128i*) (utf + i));
+      _mm_storeu_si128((__m128i*) (dest + i), _mm_unpacklo_epi8(chunk, zero));
+      _mm_storeu_si128((__m128i*) (dest + i + 8),
+                       _mm_unpackhi_epi8(chunk, zero));
+    }
+    widenASCIIScalar(utf + i, length - i, dest + i);
+  }
+
+  __attribute__((target("sse2")))
+  void widenASCIISSE2(const char* utf, nativeint length, char32_t* dest) {
+    const __m128i zero = _mm_setzero_si128();
+    nativeint i = 0;
+    for (; i + 16 <= length; i += 16) {
+      __m128i chunk = _mm_loadu_si128((const __m128i*) (utf + i));
+      __m128i low = _mm_unpacklo_epi8(chunk, zero);
+      __m128i high = _mm_unpackhi_epi8(chunk, zero);
+      _mm_storeu_si128((__m128i*) (dest + i), _mm_unpacklo_epi16(low, zero));
+      _mm_storeu_si128((__m128i*) (dest + i + 4),
+                       _mm_unpackhi_epi16(low, zero));
+      _mm_storeu_si128((__m128i*) (dest + i + 8),
+                       _mm_unpacklo_epi16(high, zero));
+      _mm_storeu_si128((__m128i*) (dest + i + 12),
+                       _mm_unpackhi_epi16(high, zero));
+    }
+    widenASCIIScalar(utf + i, length - i, dest + i);
+  }
+
+  __attribute__((target("avx2")))
+  void widenASCIIAVX2(const char* utf, nativeint length, char16_t* dest) {
+    nativeint i = 0;
+    for (; i + 16 <= length; i += 16) {
+      __m128i chunk = _mm_loadu_si128((const __m128i*) (utf + i));
+      _mm256_storeu_si256((__m256i*) (dest + i), _mm256_cvtepu8_epi16(chunk));
+    }
+    widenASCIIScalar(utf + i, length - i, dest + i);
+  }
+
+  __attribute__((target("avx2")))
+  void widenASCIIAVX2(const char* utf, nativeint length, char32_t* dest) {
+    nativeint i = 0;
+    for (; i + 8 <= length; i += 8) {
+      __m128i chunk = _mm_loadl_epi64((const __m128i*) (utf + i));
+      _mm256_storeu_si256((__m256i*) (dest + i), _mm256_cvtepu8_epi32(chunk));
+    }
+    widenASCIIScalar(utf + i, length - i, dest + i);
+  }
+
+#endif // MOZART_X86_SIMD_KERNELS
+
+  template <class C>
+  void widenASCIIDispatch(const char* utf, nativeint length, C* dest,
+                          SIMDLevel level) {
+    switch (level) {
+#ifdef MOZART_X86_SIMD_KERNELS
+      case SIMDLevel::avx2:
+        return widenASCIIAVX2(utf, length, dest);
+      case SIMDLevel::sse2:
+        return widenASCIISSE2(utf, length, dest);
+#endif
+      default:
+        return widenASCIIScalar(utf, length, dest);
+    }
+  }
+}
+
+nativeint asciiPrefixLength(const char* utf, nativeint length,
+                            SIMDLevel level) {
+  switch (level) {
+#ifdef MOZART_X86_SIMD_KERNELS
+    case SIMDLevel::avx2:
+      return asciiPrefixLengthAVX2(utf, length);
+    case SIMDLevel::sse2:
+      return asciiPrefixLengthSSE2(utf, length);
+#endif
+    default:
+      return asciiPrefixLengthScalar(utf, length);
+  }
+}
+
+void widenASCII(const char* utf, nativeint length, char16_t* dest,
+                SIMDLevel level) {
+  widenASCIIDispatch(utf, length, dest, level);
+}
+
+void widenASCII(const char* utf, nativeint length, char32_t* dest,
+                SIMDLevel level) {
+  widenASCIIDispatch(utf, length, dest, level);
+}
+
+}
+
 //////////////
 // Encoders //
 //////////////
@@ -72,9 +226,7 @@ auto encodeUTF8(const BaseLString<char>& input, EncodingVariant variant)
     result.push_back('\xbf');
   }
 
-  for (char ch : input) {
-    result.push_back(ch);
-  }
+  result.insert(result.end(), input.begin(), input.end());
 
   return std::move(result);
 }
@@ -173,11 +325,20 @@ auto decodeLatin1(const BaseLString<unsigned char>& input,
   std::vector<char> tempVector;
   tempVector.reserve(input.length);
 
+  // ASCII characters are copied as is, in bulk.
   // Characters in the range 0x80~0xff map to 2-byte sequences.
-  for (char32_t c : input) {
-    char encoded[4];
-    nativeint length = toUTF(c, encoded);   // always valid.
-    tempVector.insert(tempVector.end(), encoded, encoded + length);
+  const char* cur = reinterpret_cast<const char*>(input.begin());
+  const char* end = reinterpret_cast<const char*>(input.end());
+  while (cur < end) {
+    nativeint asciiLength = internal::asciiPrefixLength(cur, end - cur);
+    tempVector.insert(tempVector.end(), cur, cur + asciiLength);
+    cur += asciiLength;
+
+    for (; cur < end && (unsigned char) *cur >= 0x80; ++cur) {
+      char encoded[4];
+      nativeint length = toUTF((char32_t) (unsigned char) *cur, encoded);
+      tempVector.insert(tempVector.end(), encoded, encoded + length);
+    }
   }
 
   return std::move(tempVector);
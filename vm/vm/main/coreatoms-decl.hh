@@ -65,6 +65,8 @@ struct CoreAtoms {
   atom_t name;
   atom_t namedname;
   atom_t unicodeString;
+  atom_t persistentMap;
+  atom_t byteString;
 
   // Object Orientation
   unique_name_t ooMeth;
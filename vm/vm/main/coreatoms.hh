@@ -57,6 +57,8 @@ void CoreAtoms::initialize(VM vm, AtomTable& atomTable) {
   name = atomTable.get(vm, "name");
   namedname = atomTable.get(vm, "namedname");
   unicodeString = atomTable.get(vm, "unicodeString");
+  persistentMap = atomTable.get(vm, "persistentMap");
+  byteString = atomTable.get(vm, "byteString");
 
   succeeded = atomTable.get(vm, "succeeded");
   entailed = atomTable.get(vm, "entailed");
@@ -35,6 +35,7 @@
 
 #include "array-decl.hh"
 #include "atom-decl.hh"
+#include "bitarray-decl.hh"
 #include "boolean-decl.hh"
 #include "bigint-decl.hh"
 #include "bytestring-decl.hh"
@@ -46,6 +47,7 @@
 #include "foreignpointer-decl.hh"
 #include "names-decl.hh"
 #include "objects-decl.hh"
+#include "persistentmap-decl.hh"
 #include "port-decl.hh"
 #include "records-decl.hh"
 #include "reflectivetypes-decl.hh"
@@ -57,6 +59,7 @@
 #include "string-decl.hh"
 #include "unit-decl.hh"
 #include "variables-decl.hh"
+#include "vector-decl.hh"
 #include "weakrefs-decl.hh"
 
 #endif // MOZART_COREDATATYPES_DECL_H
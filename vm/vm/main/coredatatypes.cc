@@ -41,6 +41,9 @@ constexpr UUID String::uuid;
 constexpr UUID UniqueName::uuid;
 constexpr UUID Unit::uuid;
 
+// Definitions of the other static members of data types
+constexpr size_t Vector::minGrowCapacity;
+
 // Bytecode for object dispatch procedure
 const ByteCode Object::dispatchByteCode[9] = {
   OpMoveGX, 0, 1,
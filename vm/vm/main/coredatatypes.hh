@@ -35,6 +35,7 @@
 
 #include "array.hh"
 #include "atom.hh"
+#include "bitarray.hh"
 #include "boolean.hh"
 #include "bigint.hh"
 #include "bytestring.hh"
@@ -46,6 +47,7 @@
 #include "foreignpointer.hh"
 #include "names.hh"
 #include "objects.hh"
+#include "persistentmap.hh"
 #include "port.hh"
 #include "records.hh"
 #include "reflectivetypes.hh"
@@ -57,6 +59,7 @@
 #include "string.hh"
 #include "unit.hh"
 #include "variables.hh"
+#include "vector.hh"
 #include "weakrefs.hh"
 
 #endif // MOZART_COREDATATYPES_H
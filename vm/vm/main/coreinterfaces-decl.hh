@@ -98,7 +98,7 @@ struct Interface<ValueEquatable>:
 class StructuralEquatable;
 template<>
 struct Interface<StructuralEquatable>:
-  ImplementedBy<Tuple, Cons, Record, Arity>,
+  ImplementedBy<Tuple, Cons, Record, Arity, PersistentMap>,
   NoAutoReflectiveCalls {
 
   /**
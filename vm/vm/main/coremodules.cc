@@ -38,6 +38,7 @@ void registerCoreModules(VM vm) {
 
   registerBuiltinModArray(vm);
   registerBuiltinModAtom(vm);
+  registerBuiltinModBitArray(vm);
   registerBuiltinModBoot(vm);
   registerBuiltinModBrowser(vm);
   registerBuiltinModCell(vm);
@@ -56,9 +57,11 @@ void registerCoreModules(VM vm) {
   registerBuiltinModName(vm);
   registerBuiltinModNumber(vm);
   registerBuiltinModObject(vm);
+  registerBuiltinModPersistentMap(vm);
   registerBuiltinModPickle(vm);
   registerBuiltinModPort(vm);
   registerBuiltinModProcedure(vm);
+  registerBuiltinModProfile(vm);
   registerBuiltinModProperty(vm);
   registerBuiltinModRecord(vm);
   registerBuiltinModReflection(vm);
@@ -69,6 +72,7 @@ void registerCoreModules(VM vm) {
   registerBuiltinModTime(vm);
   registerBuiltinModTuple(vm);
   registerBuiltinModValue(vm);
+  registerBuiltinModVector(vm);
   registerBuiltinModVirtualByteString(vm);
   registerBuiltinModVirtualString(vm);
   registerBuiltinModWeakReference(vm);
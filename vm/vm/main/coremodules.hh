@@ -29,6 +29,7 @@
 
 #include "modules/modarray.hh"
 #include "modules/modatom.hh"
+#include "modules/modbitarray.hh"
 #include "modules/modboot.hh"
 #include "modules/modbrowser.hh"
 #include "modules/modcell.hh"
@@ -47,9 +48,11 @@
 #include "modules/modname.hh"
 #include "modules/modnumber.hh"
 #include "modules/modobject.hh"
+#include "modules/modpersistentmap.hh"
 #include "modules/modpickle.hh"
 #include "modules/modport.hh"
 #include "modules/modprocedure.hh"
+#include "modules/modprofile.hh"
 #include "modules/modproperty.hh"
 #include "modules/modrecord.hh"
 #include "modules/modreflection.hh"
@@ -60,6 +63,7 @@
 #include "modules/modtime.hh"
 #include "modules/modtuple.hh"
 #include "modules/modvalue.hh"
+#include "modules/modvector.hh"
 #include "modules/modvirtualbytestring.hh"
 #include "modules/modvirtualstring.hh"
 #include "modules/modweakref.hh"
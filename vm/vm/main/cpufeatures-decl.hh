@@ -0,0 +1,64 @@
+// Copyright © 2014, Université catholique de Louvain
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// *  Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// *  Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MOZART_CPUFEATURES_DECL_H
+#define MOZART_CPUFEATURES_DECL_H
+
+#include "core-forward-decl.hh"
+
+// Compile the SSE2 and AVX2 kernels, which are selected at run time
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MOZART_X86_SIMD_KERNELS 1
+#endif
+
+namespace mozart {
+
+/**
+ * Instruction set used by the vectorized kernels, such as the bulk UTF-8
+ * kernels and the byte search kernels. Each of them detects the best level
+ * supported by the running CPU once, the first time it is used.
+ */
+enum class SIMDLevel {
+  scalar,
+  sse2,
+  avx2
+};
+
+namespace internal {
+  inline
+  SIMDLevel detectSIMDLevel() {
+#ifdef MOZART_X86_SIMD_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+      return SIMDLevel::avx2;
+    if (__builtin_cpu_supports("sse2"))
+      return SIMDLevel::sse2;
+#endif
+    return SIMDLevel::scalar;
+  }
+}
+
+}
+
+#endif // MOZART_CPUFEATURES_DECL_H
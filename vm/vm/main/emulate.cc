@@ -275,6 +275,7 @@ void Thread::constructor(VM vm, RichNode abstraction,
 
   injectedException = nullptr;
   _terminationVar.init(vm, OptVar::build(vm, getSpace()));
+  _procedureChanged = false;
 
   // Resume the thread unless createSuspended
   if (!createSuspended)
@@ -304,9 +305,29 @@ Thread::Thread(GR gr, Thread& from): Runnable(gr, from) {
     gr->copyStableRef(injectedException, from.injectedException);
 
   gr->copyStableNode(_terminationVar, from._terminationVar);
+  _procedureChanged = false;
 }
 
 void Thread::run() {
+  PerfMap& perfMap = vm->getPerfMap();
+  if (!perfMap.isEnabled()) {
+    emulate();
+    return;
+  }
+
+  // Enter the emulator through the trampoline of the running procedure, and
+  // again through another one each time it calls or returns to another
+  do {
+    _procedureChanged = false;
+    auto trampoline = perfMap.getTrampoline(vm, *stack.front().abstraction);
+    if (trampoline != nullptr)
+      trampoline(this, &emulateThread);
+    else
+      emulate();
+  } while (_procedureChanged);
+}
+
+void Thread::emulate() {
   // Local variable cache of fields
 
   VM const vm = this->vm;
@@ -326,6 +347,9 @@ void Thread::run() {
 
   getIntermediateState().rewind(vm);
 
+  // Allocation samples are attributed to the running procedure
+  vm->getAllocationProfiler().enterThread(&abstraction, &stack);
+
   // Some helpers
 
 #define advancePC(argCount) do { PC += (argCount) + 1; } while (0)
@@ -359,9 +383,17 @@ void Thread::run() {
 
     // The big loop
 
+#ifdef MOZART_OPCODE_STATS
+    vm->getOpcodeStats().startRun();
+#endif
+
     while (!preempted) {
       OpCode op = *PC;
 
+#ifdef MOZART_OPCODE_STATS
+      vm->getOpcodeStats().record(op);
+#endif
+
       switch (op) {
         // SKIP
 
@@ -681,6 +713,11 @@ void Thread::run() {
 
           popFrame(vm, abstraction, PC, yregCount, yregs, gregs, kregs, debugEntry);
 
+          if (vm->getPerfMap().isEnabled()) {
+            preempted = true;
+            _procedureChanged = true;
+          }
+
           // Do NOT advancePC() here!
           break;
         }
@@ -923,7 +960,7 @@ void Thread::run() {
 
             default: {
               assert(false);
-              return;
+              raiseKernelError(vm, "badOpCode", (nativeint) op);
             }
           } // switch (where)
 
@@ -962,7 +999,7 @@ void Thread::run() {
 
               default: {
                 assert(false);
-                return;
+                raiseKernelError(vm, "badOpCode", (nativeint) op);
               }
             }
 
@@ -1103,7 +1140,7 @@ void Thread::run() {
 
                 default: {
                   assert(false);
-                  return;
+                  raiseKernelError(vm, "badOpCode", (nativeint) subOpCode);
                 }
               }
             }
@@ -1164,7 +1201,7 @@ void Thread::run() {
 
                 default: {
                   assert(false);
-                  return;
+                  raiseKernelError(vm, "badOpCode", (nativeint) subOpCode);
                 }
               }
             }
@@ -1202,6 +1239,10 @@ void Thread::run() {
   // The big catches clauses that catch all bad things in the world
 
   } MOZART_CATCH(vm, kind, node) {
+    // A builtin that raises, fails or suspends does not return
+    vm->getBuiltinStats().abort(kind == ExceptionKind::ekWaitBefore ||
+                                kind == ExceptionKind::ekWaitQuietBefore);
+
     if (hasBackupPC)
       PC = backupPC;
 
@@ -1242,6 +1283,8 @@ void Thread::run() {
 #undef GPC
 #undef KPC
 
+  vm->getAllocationProfiler().leaveThread();
+
   if (isTerminated())
     return;
 
@@ -1340,8 +1383,17 @@ void Thread::call(RichNode target, size_t actualArity, bool isTailCall,
 
   // Test for preemption
   // (there is no infinite execution path that does not traverse a call)
-  if (vm->testPreemption())
+  if (vm->testPreemption()) {
+    preempted = true;
+
+    // The preemption tick is also the sampling tick of the profiler
+    if (vm->getProfiler().isRunning())
+      vm->getProfiler().sample(vm, abstraction, stack);
+  } else if (vm->getPerfMap().isEnabled()) {
+    // Leave, to enter again through the trampoline of the callee
     preempted = true;
+    _procedureChanged = true;
+  }
 }
 
 void Thread::sendMsg(RichNode target, RichNode labelOrArity, size_t width,
@@ -251,6 +251,12 @@ protected:
 public:
   void dump();
 private:
+  void emulate();
+
+  static void emulateThread(void* thread) {
+    static_cast<Thread*>(thread)->emulate();
+  }
+
   inline
   void constructor(VM vm, RichNode abstraction,
                    size_t argc, RichNode args[],
@@ -349,6 +355,9 @@ private:
   ThreadStack stack;
   StableNode* injectedException;
   StableNode _terminationVar;
+
+  // Set when emulate() left to enter another procedure's perf trampoline
+  bool _procedureChanged;
 };
 
 }
@@ -29,6 +29,14 @@
 
 #include "graphreplicator-decl.hh"
 
+#include <array>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 namespace mozart {
 
 // Set this to true to print debug info about the GC
@@ -38,6 +46,162 @@ const bool OzDebugGC = true;
 const bool OzDebugGC = false;
 #endif
 
+/////////////
+// GCEvent //
+/////////////
+
+/** Statistics of one garbage collection */
+struct GCEvent {
+  GCEvent(): number(0), time(0), pause(0),
+    bytesBefore(0), bytesCopied(0), bytesFreed(0),
+    liveStableNodes(0), liveUnstableNodes(0), liveThreads(0), liveSpaces(0) {}
+
+  size_t number;       // 1 for the first GC of the VM
+  std::int64_t time;   // reference time at the start of the GC, in ms
+  std::int64_t pause;  // duration of the GC, in microseconds
+
+  size_t bytesBefore;  // allocated before the GC
+  size_t bytesCopied;  // live data copied by the GC
+  size_t bytesFreed;
+
+  size_t liveStableNodes;
+  size_t liveUnstableNodes;
+  size_t liveThreads;
+  size_t liveSpaces;
+};
+
+//////////////////
+// GCStatistics //
+//////////////////
+
+/**
+ * Statistics of the garbage collections of a VM
+ * The last events are kept in a fixed-size ring buffer, while the histogram
+ * of the pauses covers all of them.
+ */
+class GCStatistics {
+public:
+  static constexpr size_t historySize = 64;
+
+  /** Bucket i counts the pauses below histogramBase * 2^i microseconds */
+  static constexpr size_t histogramSize = 16;
+  static constexpr std::int64_t histogramBase = 128;
+
+public:
+  GCStatistics(): _count(0), _totalPause(0), _maxPause(0), _histogram() {}
+
+  void record(const GCEvent& event);
+
+  size_t getCount() {
+    return _count;
+  }
+
+  std::int64_t getTotalPause() {
+    return _totalPause;
+  }
+
+  std::int64_t getMaxPause() {
+    return _maxPause;
+  }
+
+  /** The last events, oldest first */
+  std::vector<GCEvent> getHistory();
+
+  const std::array<size_t, histogramSize>& getHistogram() {
+    return _histogram;
+  }
+
+  /** Build stats(count:_ histogram:_ lastPause:_ maxPause:_ totalPause:_) */
+  UnstableNode buildStats(VM vm);
+
+  /** Build gc(before:_ copied:_ freed:_ live:_ number:_ pause:_ time:_) */
+  static UnstableNode buildEvent(VM vm, const GCEvent& event);
+
+private:
+  std::array<GCEvent, historySize> _history;
+  size_t _count;
+  std::int64_t _totalPause;
+  std::int64_t _maxPause;
+  std::array<size_t, histogramSize> _histogram;
+};
+
+////////////////
+// HeapCensus //
+////////////////
+
+/**
+ * Census of the live heap by datatype
+ * When it is enabled, the GC takes it while it copies the live data, so that
+ * it costs a fraction of a GC we pay for anyway. Records are further split by
+ * label, and tuples by width. The bytes of an entry are those allocated when
+ * copying its values, i.e., not counting the nodes that refer to them.
+ */
+class HeapCensus {
+public:
+  struct Entry {
+    Entry(): count(0), bytes(0) {}
+
+    size_t count;
+    size_t bytes;
+  };
+
+public:
+  HeapCensus(): _enabled(false) {}
+
+  bool isEnabled() {
+    return _enabled;
+  }
+
+  void setEnabled(bool enabled) {
+    _enabled = enabled;
+  }
+
+  /**
+   * Entries of the last census, by kind, e.g., "Cons", "Tuple/2",
+   * "Record:person", "Thread" or "Space"
+   */
+  const std::map<std::string, Entry>& getEntries() {
+    return _entries;
+  }
+
+  /** Entries of the last census, by kind, largest first */
+  std::vector<std::pair<std::string, Entry>> getSortedEntries();
+
+  /** Write the entries, one per line, as "BYTES COUNT KIND" */
+  void dump(std::ostream& output);
+
+private:
+  friend class GarbageCollector;
+
+  void start();
+
+  void countNode(Type type, RichNode copy, size_t bytes);
+
+  void countThread(size_t bytes) {
+    _threads.count++;
+    _threads.bytes += bytes;
+  }
+
+  void countSpace(size_t bytes) {
+    _spaces.count++;
+    _spaces.bytes += bytes;
+  }
+
+  /** Fill in the entries, once the copied graph is complete */
+  void finish();
+
+private:
+  bool _enabled;
+  std::map<std::string, Entry> _entries;
+
+  // Working counters during a GC
+  std::unordered_map<const TypeInfo*, Entry> _types;
+  std::unordered_map<size_t, Entry> _tupleWidths;
+  std::vector<std::pair<RichNode, size_t>> _records; // labels read in finish()
+  Entry _threads;
+  Entry _spaces;
+};
+
 //////////////////////
 // GarbageCollector //
 //////////////////////
@@ -45,12 +209,22 @@ const bool OzDebugGC = false;
 class GarbageCollector: public GraphReplicator {
 public:
   GarbageCollector(VM vm, MemoryManager& sourceMM):
-    GraphReplicator(vm, sourceMM, GraphReplicator::grkGarbageCollection) {}
+    GraphReplicator(vm, sourceMM, GraphReplicator::grkGarbageCollection),
+    _liveStableNodes(0), _liveUnstableNodes(0),
+    _liveThreads(0), _liveSpaces(0), _census(nullptr) {}
 
   inline
   bool isGCRequired();
 
   void doGC(MemoryManager& secondMM);
+
+  /** Fill in the live entities found by the last GC */
+  void getLiveCounts(GCEvent& event) {
+    event.liveStableNodes = _liveStableNodes;
+    event.liveUnstableNodes = _liveUnstableNodes;
+    event.liveThreads = _liveThreads;
+    event.liveSpaces = _liveSpaces;
+  }
 private:
   friend class GraphReplicator;
 
@@ -63,6 +237,21 @@ private:
   template <class NodeType, class GCedType>
   inline
   void processNode(NodeType*& to, RichNode from);
+
+  void countLive(StableNode*) {
+    _liveStableNodes++;
+  }
+
+  void countLive(UnstableNode*) {
+    _liveUnstableNodes++;
+  }
+private:
+  size_t _liveStableNodes;
+  size_t _liveUnstableNodes;
+  size_t _liveThreads;
+  size_t _liveSpaces;
+
+  HeapCensus* _census; // nullptr unless a census is taken
 };
 
 }
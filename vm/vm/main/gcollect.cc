@@ -24,10 +24,162 @@
 
 #include "mozart.hh"
 
+#include <algorithm>
 #include <iostream>
 
 namespace mozart {
 
+//////////////////
+// GCStatistics //
+//////////////////
+
+constexpr size_t GCStatistics::historySize;
+constexpr size_t GCStatistics::histogramSize;
+constexpr std::int64_t GCStatistics::histogramBase;
+
+void GCStatistics::record(const GCEvent& event) {
+  _history[_count % historySize] = event;
+  _count++;
+
+  _totalPause += event.pause;
+  _maxPause = std::max(_maxPause, event.pause);
+
+  size_t bucket = 0;
+  std::int64_t bound = histogramBase;
+  while (event.pause >= bound && bucket < histogramSize - 1) {
+    bucket++;
+    bound *= 2;
+  }
+  _histogram[bucket]++;
+}
+
+std::vector<GCEvent> GCStatistics::getHistory() {
+  std::vector<GCEvent> result;
+  size_t first = (_count > historySize) ? _count - historySize : 0;
+  for (size_t i = first; i < _count; i++)
+    result.push_back(_history[i % historySize]);
+  return result;
+}
+
+UnstableNode GCStatistics::buildStats(VM vm) {
+  // The last bucket has no upper bound
+  OzListBuilder histogram(vm);
+  std::int64_t bound = histogramBase;
+  for (size_t i = 0; i < histogramSize; i++) {
+    if (i < histogramSize - 1)
+      histogram.push_back(vm, buildSharp(vm, (nativeint) bound,
+                                         _histogram[i]));
+    else
+      histogram.push_back(vm, buildSharp(vm, "inf", _histogram[i]));
+    bound *= 2;
+  }
+
+  std::int64_t lastPause =
+    (_count == 0) ? 0 : _history[(_count - 1) % historySize].pause;
+
+  return buildRecord(
+    vm, buildArity(vm, "stats", "count", "histogram", "lastPause",
+                   "maxPause", "totalPause"),
+    _count, histogram.get(vm), (nativeint) lastPause, (nativeint) _maxPause,
+    (nativeint) _totalPause);
+}
+
+UnstableNode GCStatistics::buildEvent(VM vm, const GCEvent& event) {
+  auto live = buildRecord(
+    vm, buildArity(vm, "live", "spaces", "stable", "threads", "unstable"),
+    event.liveSpaces, event.liveStableNodes, event.liveThreads,
+    event.liveUnstableNodes);
+
+  return buildRecord(
+    vm, buildArity(vm, "gc", "before", "copied", "freed", "live", "number",
+                   "pause", "time"),
+    event.bytesBefore, event.bytesCopied, event.bytesFreed, std::move(live),
+    event.number, (nativeint) event.pause, (nativeint) event.time);
+}
+
+////////////////
+// HeapCensus //
+////////////////
+
+void HeapCensus::start() {
+  _types.clear();
+  _tupleWidths.clear();
+  _records.clear();
+  _threads = Entry();
+  _spaces = Entry();
+}
+
+void HeapCensus::countNode(Type type, RichNode copy, size_t bytes) {
+  if (type == Tuple::type()) {
+    auto& entry = _tupleWidths[copy.as<Tuple>().getWidth()];
+    entry.count++;
+    entry.bytes += bytes;
+  } else if (type == Record::type()) {
+    // The label may not be copied yet, look at it when the GC is done
+    _records.emplace_back(copy, bytes);
+  } else {
+    auto& entry = _types[type.info()];
+    entry.count++;
+    entry.bytes += bytes;
+  }
+}
+
+void HeapCensus::finish() {
+  _entries.clear();
+
+  for (auto& type : _types)
+    _entries[type.first->getName()] = type.second;
+
+  for (auto& width : _tupleWidths)
+    _entries["Tuple/" + std::to_string(width.first)] = width.second;
+
+  for (auto& record : _records) {
+    auto arity = RichNode(*record.first.as<Record>().getArity());
+    auto label = RichNode(*arity.as<Arity>().getLabel());
+
+    std::string kind;
+    if (label.is<Atom>()) {
+      auto atom = label.as<Atom>().value();
+      kind = "Record:" + std::string(atom.contents(), atom.length());
+    } else {
+      kind = "Record:<" + label.type()->getName() + ">";
+    }
+
+    auto& entry = _entries[kind];
+    entry.count++;
+    entry.bytes += record.second;
+  }
+
+  if (_threads.count != 0)
+    _entries["Thread"] = _threads;
+  if (_spaces.count != 0)
+    _entries["Space"] = _spaces;
+
+  _types.clear();
+  _tupleWidths.clear();
+  _records.clear();
+}
+
+std::vector<std::pair<std::string, HeapCensus::Entry>>
+HeapCensus::getSortedEntries() {
+  std::vector<std::pair<std::string, Entry>> result(
+    _entries.begin(), _entries.end());
+
+  std::stable_sort(result.begin(), result.end(),
+    [] (const std::pair<std::string, Entry>& left,
+        const std::pair<std::string, Entry>& right) {
+      return left.second.bytes > right.second.bytes;
+    });
+
+  return result;
+}
+
+void HeapCensus::dump(std::ostream& output) {
+  for (auto& entry : getSortedEntries())
+    output << entry.second.bytes << " " << entry.second.count << " "
+           << entry.first << "\n";
+}
+
 //////////////////////
 // GarbageCollector //
 //////////////////////
@@ -41,6 +193,15 @@ void GarbageCollector::doGC(MemoryManager& secondMM) {
   // General assumptions when running GC
   assert(vm->_currentSpace == vm->_topLevelSpace);
 
+  _liveStableNodes = 0;
+  _liveUnstableNodes = 0;
+  _liveThreads = 0;
+  _liveSpaces = 0;
+
+  _census = vm->getHeapCensus().isEnabled() ? &vm->getHeapCensus() : nullptr;
+  if (_census != nullptr)
+    _census->start();
+
   // Before GR
   vm->beforeGR(this);
 
@@ -50,6 +211,11 @@ void GarbageCollector::doGC(MemoryManager& secondMM) {
   // GC loop
   runCopyLoop<GarbageCollector>();
 
+  if (_census != nullptr) {
+    _census->finish();
+    _census = nullptr;
+  }
+
   // After GR
   vm->afterGR(this);
 
@@ -60,16 +226,43 @@ void GarbageCollector::doGC(MemoryManager& secondMM) {
 }
 
 void GarbageCollector::processSpace(SpaceRef& to, SpaceRef from) {
-  to = from->gCollectOuter(this);
+  _liveSpaces++;
+
+  if (_census == nullptr) {
+    to = from->gCollectOuter(this);
+  } else {
+    size_t before = vm->getMemoryManager().getAllocated();
+    to = from->gCollectOuter(this);
+    _census->countSpace(vm->getMemoryManager().getAllocated() - before);
+  }
 }
 
 void GarbageCollector::processThread(Runnable*& to, Runnable* from) {
-  to = from->gCollectOuter(this);
+  _liveThreads++;
+
+  if (_census == nullptr) {
+    to = from->gCollectOuter(this);
+  } else {
+    size_t before = vm->getMemoryManager().getAllocated();
+    to = from->gCollectOuter(this);
+    _census->countThread(vm->getMemoryManager().getAllocated() - before);
+  }
 }
 
 template <class NodeType, class GCedType>
 void GarbageCollector::processNode(NodeType*& to, RichNode from) {
-  from.type()->gCollect(this, from, *to);
+  countLive(to);
+
+  if (_census == nullptr) {
+    from.type()->gCollect(this, from, *to);
+  } else {
+    Type type = from.type();
+    size_t before = vm->getMemoryManager().getAllocated();
+    type->gCollect(this, from, *to);
+    _census->countNode(type, *to,
+                       vm->getMemoryManager().getAllocated() - before);
+  }
+
   from.reinit(vm, GCedType::build(vm, to));
 }
 
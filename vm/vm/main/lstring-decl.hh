@@ -176,6 +176,10 @@ struct LString : BaseLString<C> {
   static constexpr const LString<C>
       fromLiteral(const C (&str)[n], nativeint len=n-1) { return {str, len}; }
 
+  // Alias memory that is not in the heap, and kept alive by other means.
+  static constexpr const LString<C>
+      fromExternal(const C* str, nativeint len) { return {str, len}; }
+
 private:
   constexpr LString(const C* str, nativeint len) : BaseLString<C>(str, len) {}
 };
@@ -249,6 +253,32 @@ inline auto newLStringInit(VM vm, nativeint len, const F& func)
 template <class C>
 inline LString<C> concatLString(VM vm, const LString<C>& a, const LString<C>& b);
 
+/**
+ * Find the first occurrence of needle in haystack.
+ *
+ * @return
+ *      A pointer to the beginning of the match, or haystack.end() if there is
+ *      none. An empty needle matches at haystack.begin().
+ */
+template <class C>
+inline const C* searchLString(const BaseLString<C>& haystack,
+                              const BaseLString<C>& needle);
+
+/**
+ * Find the first position of haystack where any of the given needles occurs.
+ * If several needles match at that position, the first one in needles wins.
+ *
+ * @param which
+ *      Receives the index of the matching needle in needles.
+ * @return
+ *      A pointer to the beginning of the match, or haystack.end() if none of
+ *      the needles occur.
+ */
+template <class C>
+inline const C* searchAnyLString(const BaseLString<C>& haystack,
+                                 const BaseLString<C>* const* needles,
+                                 size_t needleCount, size_t& which);
+
 }
 
 #endif // MOZART_LSTRING_DECL_H
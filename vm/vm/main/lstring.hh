@@ -227,6 +227,215 @@ LString<C> concatLString(VM vm, const LString<C>& a, const LString<C>& b) {
   });
 }
 
+// Searching -------------------------------------------------------------------
+
+namespace internal {
+  // Needles at least that long are searched with Boyer-Moore-Horspool, which
+  // skips ahead by up to their length. Shorter ones are found by filtering
+  // candidate positions on their first byte with memchr(), which libc
+  // implementations vectorize.
+  constexpr nativeint minHorspoolNeedleLength = 8;
+
+  inline
+  const unsigned char* firstByteSearch(const unsigned char* begin,
+                                       const unsigned char* end,
+                                       const unsigned char* needle,
+                                       nativeint needleLength) {
+    const unsigned char* lastStart = end - needleLength;
+    const unsigned char* cur = begin;
+
+    while (cur <= lastStart) {
+      cur = static_cast<const unsigned char*>(
+        memchr(cur, needle[0], lastStart - cur + 1));
+      if (cur == nullptr)
+        return end;
+      if (memcmp(cur + 1, needle + 1, needleLength - 1) == 0)
+        return cur;
+      ++cur;
+    }
+
+    return end;
+  }
+
+  inline
+  const unsigned char* horspoolSearch(const unsigned char* begin,
+                                      const unsigned char* end,
+                                      const unsigned char* needle,
+                                      nativeint needleLength) {
+    nativeint skip[256];
+    std::fill(skip, skip + 256, needleLength);
+    for (nativeint i = 0; i < needleLength - 1; ++i)
+      skip[needle[i]] = needleLength - 1 - i;
+
+    const unsigned char lastByte = needle[needleLength - 1];
+    const unsigned char* lastStart = end - needleLength;
+    const unsigned char* cur = begin;
+
+    while (cur <= lastStart) {
+      unsigned char c = cur[needleLength - 1];
+      if (c == lastByte && memcmp(cur, needle, needleLength - 1) == 0)
+        return cur;
+      cur += skip[c];
+    }
+
+    return end;
+  }
+
+  inline
+  const unsigned char* byteSearch(const unsigned char* begin,
+                                  const unsigned char* end,
+                                  const unsigned char* needle,
+                                  nativeint needleLength) {
+    if (needleLength == 0)
+      return begin;
+    else if (needleLength > end - begin)
+      return end;
+    else if (needleLength < minHorspoolNeedleLength)
+      return firstByteSearch(begin, end, needle, needleLength);
+    else
+      return horspoolSearch(begin, end, needle, needleLength);
+  }
+
+  // Up to that many distinct first bytes, searchAny() filters candidate
+  // positions with the vector kernels of findAnyByte(). More are looked up in
+  // a table, one byte at a time.
+  constexpr size_t maxFindAnyBytes = 4;
+
+  /**
+   * First position of [begin, end) that holds one of the byteCount bytes of
+   * bytes, or end. byteCount is at most maxFindAnyBytes.
+   */
+  const unsigned char* findAnyByte(const unsigned char* begin,
+                                   const unsigned char* end,
+                                   const unsigned char* bytes,
+                                   size_t byteCount, SIMDLevel level);
+
+  inline
+  const unsigned char* findAnyByte(const unsigned char* begin,
+                                   const unsigned char* end,
+                                   const unsigned char* bytes,
+                                   size_t byteCount) {
+    static const SIMDLevel level = detectSIMDLevel();
+    return findAnyByte(begin, end, bytes, byteCount, level);
+  }
+
+  inline
+  const unsigned char* byteSearchAny(const unsigned char* begin,
+                                     const unsigned char* end,
+                                     const unsigned char* const* needles,
+                                     const nativeint* needleLengths,
+                                     size_t needleCount, size_t& which) {
+    bool isFirstByte[256] = {};
+    unsigned char firstBytes[maxFindAnyBytes];
+    size_t firstByteCount = 0;
+    for (size_t i = 0; i < needleCount; ++i) {
+      if (needleLengths[i] == 0) {
+        which = i;
+        return begin;
+      }
+      unsigned char firstByte = needles[i][0];
+      if (!isFirstByte[firstByte]) {
+        isFirstByte[firstByte] = true;
+        if (firstByteCount < maxFindAnyBytes)
+          firstBytes[firstByteCount] = firstByte;
+        ++firstByteCount;
+      }
+    }
+
+    bool vectorized = firstByteCount <= maxFindAnyBytes;
+    const unsigned char* cur = begin;
+    while (true) {
+      if (vectorized) {
+        cur = findAnyByte(cur, end, firstBytes, firstByteCount);
+      } else {
+        while (cur < end && !isFirstByte[*cur])
+          ++cur;
+      }
+
+      if (cur == end)
+        return end;
+
+      for (size_t i = 0; i < needleCount; ++i) {
+        if ((needleLengths[i] <= end - cur) &&
+            (memcmp(cur, needles[i], needleLengths[i]) == 0)) {
+          which = i;
+          return cur;
+        }
+      }
+      ++cur;
+    }
+  }
+
+  template <class C, bool isByte = (sizeof(C) == 1)>
+  struct LStringSearcher {
+    static const C* search(const BaseLString<C>& haystack,
+                           const BaseLString<C>& needle) {
+      return std::search(haystack.begin(), haystack.end(),
+                         needle.begin(), needle.end());
+    }
+
+    static const C* searchAny(const BaseLString<C>& haystack,
+                              const BaseLString<C>* const* needles,
+                              size_t needleCount, size_t& which) {
+      const C* result = haystack.end();
+      for (size_t i = 0; i < needleCount; ++i) {
+        const C* found = std::search(haystack.begin(), haystack.end(),
+                                     needles[i]->begin(), needles[i]->end());
+        if (found < result) {
+          result = found;
+          which = i;
+        }
+      }
+      return result;
+    }
+  };
+
+  template <class C>
+  struct LStringSearcher<C, true> {
+    static const unsigned char* bytes(const C* str) {
+      return reinterpret_cast<const unsigned char*>(str);
+    }
+
+    static const C* search(const BaseLString<C>& haystack,
+                           const BaseLString<C>& needle) {
+      auto found = byteSearch(bytes(haystack.begin()), bytes(haystack.end()),
+                              bytes(needle.begin()), needle.length);
+      return reinterpret_cast<const C*>(found);
+    }
+
+    static const C* searchAny(const BaseLString<C>& haystack,
+                              const BaseLString<C>* const* needles,
+                              size_t needleCount, size_t& which) {
+      std::vector<const unsigned char*> needleBytes(needleCount);
+      std::vector<nativeint> needleLengths(needleCount);
+      for (size_t i = 0; i < needleCount; ++i) {
+        needleBytes[i] = bytes(needles[i]->begin());
+        needleLengths[i] = needles[i]->length;
+      }
+
+      auto found = byteSearchAny(bytes(haystack.begin()),
+                                 bytes(haystack.end()),
+                                 needleBytes.data(), needleLengths.data(),
+                                 needleCount, which);
+      return reinterpret_cast<const C*>(found);
+    }
+  };
+}
+
+template <class C>
+const C* searchLString(const BaseLString<C>& haystack,
+                       const BaseLString<C>& needle) {
+  return internal::LStringSearcher<C>::search(haystack, needle);
+}
+
+template <class C>
+const C* searchAnyLString(const BaseLString<C>& haystack,
+                          const BaseLString<C>* const* needles,
+                          size_t needleCount, size_t& which) {
+  return internal::LStringSearcher<C>::searchAny(haystack, needles,
+                                                 needleCount, which);
+}
+
 }
 
 #endif // MOZART_LSTRING_H
@@ -60,6 +60,32 @@ void MemoryManager::init(VM vm) {
   for (size_t i = 0; i < MaxBuckets; i++)
     freeListBuckets[i] = nullptr;
   _allocatedInFreeList = 0;
+
+  resetSampling();
+}
+
+void* MemoryManager::getMemorySlow(size_t size) {
+  if (_sampleInterval != 0 && getAllocated() + size > _nextSample)
+    takeSample(size);
+
+  if (_allocated + size > _blockSize) {
+    return getMoreMemory(size);
+  } else {
+    void* result = static_cast<void*>(_nextBlock);
+    _nextBlock += size;
+    _allocated += size;
+    return result;
+  }
+}
+
+void MemoryManager::takeSample(size_t size) {
+  size_t allocated = getAllocated() + size;
+  while (_nextSample < allocated)
+    _nextSample += _sampleInterval;
+  updateLimit();
+
+  // The profiler must not allocate in this memory manager
+  vm->getAllocationProfiler().sample(vm);
 }
 
 void* MemoryManager::getMoreMemory(size_t size) {
@@ -73,6 +99,7 @@ void* MemoryManager::getMoreMemory(size_t size) {
 
   _extraAllocs.push_front(ptr);
   _allocatedInExtra += size;
+  updateLimit();
 
   // Adjust the heap size so we do not need to GC twice
   size_t activeMemory = vm->getPropertyRegistry().stats.activeMemory + size;
@@ -92,6 +119,7 @@ void MemoryManager::releaseExtraAllocs() {
     _extraAllocs.pop_front();
   }
   _allocatedInExtra = 0;
+  updateLimit();
 }
 
 }
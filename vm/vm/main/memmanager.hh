@@ -38,8 +38,9 @@ const size_t MegaBytes = 1024*1024;
 class MemoryManager {
 public:
   MemoryManager() : vm(nullptr),
-    _nextBlock(nullptr), _baseBlock(nullptr), _blockSize(0),
-    _allocated(0), _allocatedInFreeList(0), _allocatedInExtra(0) {}
+    _nextBlock(nullptr), _baseBlock(nullptr), _blockSize(0), _limit(0),
+    _allocated(0), _allocatedInFreeList(0), _allocatedInExtra(0),
+    _sampleInterval(0), _nextSample(0) {}
 
   ~MemoryManager() {
     ::free(_baseBlock);
@@ -51,8 +52,8 @@ public:
   // Memory requests and releases
 
   void* getMemory(size_t size) {
-    if (_allocated + size > _blockSize) {
-      return getMoreMemory(size);
+    if (_allocated + size > _limit) {
+      return getMemorySlow(size);
     } else {
       void* result = static_cast<void*>(_nextBlock);
       _nextBlock += size;
@@ -108,8 +109,40 @@ private:
     return (size + (AllocGranularity-1)) / AllocGranularity;
   }
 
+  void* getMemorySlow(size_t size);
+
   void* getMoreMemory(size_t size);
 
+public:
+  // Allocation sampling
+
+  /**
+   * Call AllocationProfiler::sample() about every `interval` bytes allocated
+   * Sampling shares the test of the end of the block in getMemory(), so that
+   * it costs nothing when it is disabled, with an interval of 0.
+   */
+  void setSampleInterval(size_t interval) {
+    _sampleInterval = interval;
+    resetSampling();
+  }
+
+private:
+  void resetSampling() {
+    _nextSample = getAllocated() + _sampleInterval;
+    updateLimit();
+  }
+
+  void updateLimit() {
+    _limit = _blockSize;
+    if (_sampleInterval != 0) {
+      size_t nextSampleInBlock =
+        (_nextSample > _allocatedInExtra) ? _nextSample - _allocatedInExtra : 0;
+      _limit = std::min(_limit, nextSampleInBlock);
+    }
+  }
+
+  void takeSample(size_t size);
+
 public:
   // Query statistics and properties
 
@@ -135,6 +168,7 @@ public:
     std::swap(_nextBlock, other._nextBlock);
     std::swap(_baseBlock, other._baseBlock);
     std::swap(_blockSize, other._blockSize);
+    std::swap(_limit, other._limit);
     std::swap(_allocated, other._allocated);
     std::swap(freeListBuckets, other.freeListBuckets);
     std::swap(_allocatedInFreeList, other._allocatedInFreeList);
@@ -153,6 +187,7 @@ private:
   char* _baseBlock;
 
   size_t _blockSize;
+  size_t _limit; // _blockSize, or less to take the next sample
   size_t _allocated; // in _baseBlock
 
   void* freeListBuckets[MaxBuckets];
@@ -160,6 +195,10 @@ private:
 
   std::forward_list<void*> _extraAllocs;
   size_t _allocatedInExtra; // So it can be reset to 0 after releaseExtraAllocs()
+
+  // Sampling settings stay with this manager when it is swapped
+  size_t _sampleInterval; // 0 when disabled
+  size_t _nextSample; // in terms of getAllocated()
 };
 
 }
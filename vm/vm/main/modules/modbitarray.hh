@@ -0,0 +1,223 @@
+// Copyright © 2014, Université catholique de Louvain
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// *  Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// *  Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MOZART_MODBITARRAY_H
+#define MOZART_MODBITARRAY_H
+
+#include "../mozartcore.hh"
+
+#ifndef MOZART_GENERATOR
+
+namespace mozart {
+
+namespace builtins {
+
+/////////////////////
+// BitArray module //
+/////////////////////
+
+class ModBitArray: public Module {
+public:
+  ModBitArray(): Module("BitArray") {}
+
+  static TypedRichNode<BitArray> getBitArray(VM vm, RichNode bitArray) {
+    if (bitArray.is<BitArray>())
+      return bitArray.as<BitArray>();
+    else if (bitArray.isTransient())
+      waitFor(vm, bitArray);
+    else
+      raiseTypeError(vm, "BitArray", bitArray);
+  }
+
+  class New: public Builtin<New> {
+  public:
+    New(): Builtin("new") {}
+
+    static void call(VM vm, In low, In high, Out result) {
+      auto intLow = getArgument<nativeint>(vm, low, "integer");
+      auto intHigh = getArgument<nativeint>(vm, high, "integer");
+
+      nativeint width = intHigh - intLow + 1;
+      if (width < 0)
+        raiseKernelError(vm, "BitArray.new", low, high);
+
+      result = BitArray::build(vm, BitArray::wordCountFor((size_t) width),
+                               intLow, intHigh);
+    }
+  };
+
+  class Is: public Builtin<Is> {
+  public:
+    Is(): Builtin("is") {}
+
+    static void call(VM vm, In value, Out result) {
+      if (value.isTransient())
+        waitFor(vm, value);
+      result = build(vm, value.is<BitArray>());
+    }
+  };
+
+  class Test: public Builtin<Test> {
+  public:
+    Test(): Builtin("test") {}
+
+    static void call(VM vm, In bitArray, In index, Out result) {
+      result = build(vm, getBitArray(vm, bitArray).test(vm, index));
+    }
+  };
+
+  class Set: public Builtin<Set> {
+  public:
+    Set(): Builtin("set") {}
+
+    static void call(VM vm, In bitArray, In index) {
+      getBitArray(vm, bitArray).set(vm, index);
+    }
+  };
+
+  class Clear: public Builtin<Clear> {
+  public:
+    Clear(): Builtin("clear") {}
+
+    static void call(VM vm, In bitArray, In index) {
+      getBitArray(vm, bitArray).clear(vm, index);
+    }
+  };
+
+  class Low: public Builtin<Low> {
+  public:
+    Low(): Builtin("low") {}
+
+    static void call(VM vm, In bitArray, Out result) {
+      result = getBitArray(vm, bitArray).low(vm);
+    }
+  };
+
+  class High: public Builtin<High> {
+  public:
+    High(): Builtin("high") {}
+
+    static void call(VM vm, In bitArray, Out result) {
+      result = getBitArray(vm, bitArray).high(vm);
+    }
+  };
+
+  class Clone: public Builtin<Clone> {
+  public:
+    Clone(): Builtin("clone") {}
+
+    static void call(VM vm, In bitArray, Out result) {
+      result = getBitArray(vm, bitArray).clone(vm);
+    }
+  };
+
+  class Disj: public Builtin<Disj> {
+  public:
+    Disj(): Builtin("disj") {}
+
+    static void call(VM vm, In left, In right) {
+      getBitArray(vm, left).disj(vm, right);
+    }
+  };
+
+  class Conj: public Builtin<Conj> {
+  public:
+    Conj(): Builtin("conj") {}
+
+    static void call(VM vm, In left, In right) {
+      getBitArray(vm, left).conj(vm, right);
+    }
+  };
+
+  class ExclDisj: public Builtin<ExclDisj> {
+  public:
+    ExclDisj(): Builtin("exclDisj") {}
+
+    static void call(VM vm, In left, In right) {
+      getBitArray(vm, left).exclDisj(vm, right);
+    }
+  };
+
+  class Nimpl: public Builtin<Nimpl> {
+  public:
+    Nimpl(): Builtin("nimpl") {}
+
+    static void call(VM vm, In left, In right) {
+      getBitArray(vm, left).nimpl(vm, right);
+    }
+  };
+
+  class Disjoint: public Builtin<Disjoint> {
+  public:
+    Disjoint(): Builtin("disjoint") {}
+
+    static void call(VM vm, In left, In right, Out result) {
+      result = build(vm, getBitArray(vm, left).disjoint(vm, right));
+    }
+  };
+
+  class Subsumes: public Builtin<Subsumes> {
+  public:
+    Subsumes(): Builtin("subsumes") {}
+
+    static void call(VM vm, In left, In right, Out result) {
+      result = build(vm, getBitArray(vm, left).subsumes(vm, right));
+    }
+  };
+
+  class Card: public Builtin<Card> {
+  public:
+    Card(): Builtin("card") {}
+
+    static void call(VM vm, In bitArray, Out result) {
+      result = build(vm, getBitArray(vm, bitArray).card(vm));
+    }
+  };
+
+  class ToList: public Builtin<ToList> {
+  public:
+    ToList(): Builtin("toList") {}
+
+    static void call(VM vm, In bitArray, Out result) {
+      result = getBitArray(vm, bitArray).toList(vm);
+    }
+  };
+
+  class ComplementToList: public Builtin<ComplementToList> {
+  public:
+    ComplementToList(): Builtin("complementToList") {}
+
+    static void call(VM vm, In bitArray, Out result) {
+      result = getBitArray(vm, bitArray).complementToList(vm);
+    }
+  };
+};
+
+}
+
+}
+
+#endif // MOZART_GENERATOR
+
+#endif // MOZART_MODBITARRAY_H
@@ -95,6 +95,71 @@ public:
     }
   };
 
+  class SearchAny : public Builtin<SearchAny> {
+  public:
+    SearchAny() : Builtin("searchAny") {}
+
+    static void call(VM vm, In value, In from, In needles,
+                     Out begin, Out end) {
+      using namespace patternmatching;
+
+      auto bytes = StringLike(value).byteStringGet(vm);
+      auto fromOffset = getArgument<nativeint>(vm, from, "integer");
+
+      if (fromOffset < 0 || fromOffset > bytes->length)
+        raiseIndexOutOfBounds(vm, fromOffset);
+
+      // Needles can be byte strings or single bytes. Check them all before
+      // allocating the vectors below, since raising skips their destructors.
+      size_t needleCount = 0;
+      ozListForEach(vm, needles,
+        [&] (RichNode needle) {
+          nativeint character = 0;
+          if (matches(vm, needle, capture(character))) {
+            if (character < 0 || character >= 0x100)
+              raiseTypeError(vm, "Integer between 0 and 255", needle);
+          } else {
+            StringLike(needle).byteStringGet(vm);
+          }
+          ++needleCount;
+        },
+        "list of byte strings or bytes");
+
+      std::vector<unsigned char> singleBytes(needleCount);
+      std::vector<mut::BaseLString<unsigned char>> needleStorage;
+      std::vector<const BaseLString<unsigned char>*> needleStrings;
+      needleStorage.reserve(needleCount);
+      needleStrings.reserve(needleCount);
+
+      ozListForEach(vm, needles,
+        [&] (RichNode needle, size_t index) {
+          nativeint character = 0;
+          if (matches(vm, needle, capture(character))) {
+            singleBytes[index] = (unsigned char) character;
+            needleStorage.emplace_back(&singleBytes[index], 1);
+            needleStrings.push_back(&needleStorage.back());
+          } else {
+            needleStrings.push_back(StringLike(needle).byteStringGet(vm));
+          }
+        },
+        "list of byte strings or bytes");
+
+      LString<unsigned char> haystack = bytes->slice(fromOffset);
+      size_t which = 0;
+      auto foundIter = searchAnyLString(haystack, needleStrings.data(),
+                                        needleStrings.size(), which);
+
+      if (foundIter == haystack.end()) {
+        begin = build(vm, false);
+        end = build(vm, false);
+      } else {
+        nativeint foundOffset = foundIter - bytes->string;
+        begin = build(vm, foundOffset);
+        end = build(vm, foundOffset + needleStrings[which]->length);
+      }
+    }
+  };
+
   class HasPrefix : public Builtin<HasPrefix> {
   public:
     HasPrefix() : Builtin("hasPrefix") {}
@@ -0,0 +1,171 @@
+// Copyright © 2014, Université catholique de Louvain
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// *  Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// *  Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+#ifndef MOZART_MODPERSISTENTMAP_H
+#define MOZART_MODPERSISTENTMAP_H
+
+#include "../mozartcore.hh"
+
+#ifndef MOZART_GENERATOR
+
+namespace mozart {
+
+namespace builtins {
+
+//////////////////////////
+// PersistentMap module //
+//////////////////////////
+
+class ModPersistentMap: public Module {
+public:
+  ModPersistentMap(): Module("PersistentMap") {}
+
+  static TypedRichNode<PersistentMap> getMap(VM vm, RichNode map) {
+    if (map.is<PersistentMap>())
+      return map.as<PersistentMap>();
+    else if (map.isTransient())
+      waitFor(vm, map);
+    else
+      raiseTypeError(vm, "PersistentMap", map);
+  }
+
+  class New: public Builtin<New> {
+  public:
+    New(): Builtin("new") {}
+
+    static void call(VM vm, Out result) {
+      result = PersistentMap::build(vm);
+    }
+  };
+
+  class Is: public Builtin<Is> {
+  public:
+    Is(): Builtin("is") {}
+
+    static void call(VM vm, In value, Out result) {
+      if (value.isTransient())
+        waitFor(vm, value);
+      result = build(vm, value.is<PersistentMap>());
+    }
+  };
+
+  class Size: public Builtin<Size> {
+  public:
+    Size(): Builtin("size") {}
+
+    static void call(VM vm, In map, Out result) {
+      result = build(vm, getMap(vm, map).getSize());
+    }
+  };
+
+  class Member: public Builtin<Member> {
+  public:
+    Member(): Builtin("member") {}
+
+    static void call(VM vm, In map, In key, Out result) {
+      result = build(vm, getMap(vm, map).member(vm, key));
+    }
+  };
+
+  class Get: public Builtin<Get> {
+  public:
+    Get(): Builtin("get") {}
+
+    static void call(VM vm, In map, In key, Out result) {
+      result = getMap(vm, map).get(vm, key);
+    }
+  };
+
+  class CondGet: public Builtin<CondGet> {
+  public:
+    CondGet(): Builtin("condGet") {}
+
+    static void call(VM vm, In map, In key, In defaultValue, Out result) {
+      result = getMap(vm, map).condGet(vm, key, defaultValue);
+    }
+  };
+
+  class Put: public Builtin<Put> {
+  public:
+    Put(): Builtin("put") {}
+
+    static void call(VM vm, In map, In key, In value, Out result) {
+      result = getMap(vm, map).put(vm, key, value);
+    }
+  };
+
+  class Remove: public Builtin<Remove> {
+  public:
+    Remove(): Builtin("remove") {}
+
+    static void call(VM vm, In map, In key, Out result) {
+      result = getMap(vm, map).remove(vm, key);
+    }
+  };
+
+  class Keys: public Builtin<Keys> {
+  public:
+    Keys(): Builtin("keys") {}
+
+    static void call(VM vm, In map, Out result) {
+      result = getMap(vm, map).keys(vm);
+    }
+  };
+
+  class Items: public Builtin<Items> {
+  public:
+    Items(): Builtin("items") {}
+
+    static void call(VM vm, In map, Out result) {
+      result = getMap(vm, map).items(vm);
+    }
+  };
+
+  class Entries: public Builtin<Entries> {
+  public:
+    Entries(): Builtin("entries") {}
+
+    static void call(VM vm, In map, Out result) {
+      result = getMap(vm, map).entries(vm);
+    }
+  };
+
+  class ToRecord: public Builtin<ToRecord> {
+  public:
+    ToRecord(): Builtin("toRecord") {}
+
+    static void call(VM vm, In label, In map, Out result) {
+      result = getMap(vm, map).toRecord(vm, label);
+    }
+  };
+};
+
+}
+
+}
+
+#endif // MOZART_GENERATOR
+
+#endif // MOZART_MODPERSISTENTMAP_H
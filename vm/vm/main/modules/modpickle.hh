@@ -27,7 +27,12 @@
 
 #include "../mozartcore.hh"
 
+#include <cerrno>
+#include <cstring>
 #include <fstream>
+#include <vector>
+
+#include <sys/stat.h>
 
 #ifndef MOZART_GENERATOR
 
@@ -39,7 +44,36 @@ namespace builtins {
 // Pickle module //
 ///////////////////
 
+// Pickles that cannot be written raise the same error as the OS module
+inline
+void raisePickleFileError(VM vm, const char* function, int errnum) {
+  raiseSystem(vm, "os", "os", function, (nativeint) errnum,
+              vm->getAtom(std::strerror(errnum)));
+}
+
 class ModPickle: public Module {
+private:
+  static PickleOptions parseOptions(VM vm, In compression, In level) {
+    using namespace patternmatching;
+
+    PickleOptions options;
+
+    if (matches(vm, compression, "none")) {
+      options.compression = PickleCompression::none;
+    } else if (matches(vm, compression, "zlib")) {
+      options.compression = PickleCompression::zlib;
+    } else {
+      raiseTypeError(vm, "none or zlib", compression);
+    }
+
+    auto intLevel = getArgument<nativeint>(vm, level, "integer");
+    if (intLevel < 1 || intLevel > 9)
+      raiseTypeError(vm, "integer between 1 and 9", level);
+    options.level = (int) intLevel;
+
+    return options;
+  }
+
 public:
   ModPickle(): Module("Pickle") {}
 
@@ -48,9 +82,23 @@ public:
     Pack(): Builtin("pack") {}
 
     static void call(VM vm, In value, In temporaryReplacement, Out result) {
-      std::ostringstream buf;
-      pickle(vm, value, temporaryReplacement, buf);
-      std::string str = buf.str();
+      std::string str;
+      pickle(vm, value, temporaryReplacement, str);
+      auto bytes = newLString(vm,
+        reinterpret_cast<const unsigned char*>(str.data()), str.size());
+      result = ByteString::build(vm, bytes);
+    }
+  };
+
+  class PackWithOptions: public Builtin<PackWithOptions> {
+  public:
+    PackWithOptions(): Builtin("packWithOptions") {}
+
+    static void call(VM vm, In value, In temporaryReplacement,
+                     In compression, In level, Out result) {
+      auto options = parseOptions(vm, compression, level);
+      std::string str;
+      pickle(vm, value, temporaryReplacement, options, str);
       auto bytes = newLString(vm,
         reinterpret_cast<const unsigned char*>(str.data()), str.size());
       result = ByteString::build(vm, bytes);
@@ -62,15 +110,19 @@ public:
     Unpack(): Builtin("unpack") {}
 
     static void call(VM vm, In vbs, Out result) {
+      // Unpickle a byte string in place
+      if (vbs.is<ByteString>()) {
+        auto& bytes = vbs.as<ByteString>().value();
+        result = unpickle(vm, bytes.string, bytes.length);
+        return;
+      }
+
       // VBS to vector<unsigned char>
       size_t bufSize = ozVBSLengthForBuffer(vm, vbs);
       std::vector<unsigned char> buffer;
       ozVBSGet(vm, vbs, bufSize, buffer);
 
-      // unpickle
-      std::string str(buffer.begin(), buffer.end());
-      std::istringstream input(str);
-      result = unpickle(vm, input);
+      result = unpickle(vm, buffer.data(), buffer.size());
     }
   };
 
@@ -88,6 +140,49 @@ public:
     }
   };
 
+  class SaveWithOptions: public Builtin<SaveWithOptions> {
+  public:
+    SaveWithOptions(): Builtin("saveWithOptions") {}
+
+    static void call(VM vm, In value, In temporaryReplacement, In fileNameVS,
+                     In compression, In level) {
+      auto options = parseOptions(vm, compression, level);
+
+      // The file and its name are freed before any raise
+      const char* function = nullptr;
+      int errnum = 0;
+      {
+        size_t fileNameSize = ozVSLengthForBuffer(vm, fileNameVS);
+        std::string fileName;
+        ozVSGet(vm, fileNameVS, fileNameSize, fileName);
+
+        std::ofstream file(fileName, std::ios_base::binary);
+        if (!file) {
+          function = "open";
+          errnum = errno;
+        } else {
+          MOZART_TRY(vm) {
+            pickle(vm, value, temporaryReplacement, options, file);
+          } MOZART_CATCH(vm, kind, node) {
+            // The raise skips the destructors of file and fileName
+            file.close();
+            std::string().swap(fileName);
+            MOZART_RETHROW(vm);
+          } MOZART_ENDTRY(vm);
+
+          file.close();
+          if (!file) {
+            function = "write";
+            errnum = errno;
+          }
+        }
+      }
+
+      if (function != nullptr)
+        raisePickleFileError(vm, function, errnum);
+    }
+  };
+
   class Load: public Builtin<Load> {
   public:
     Load(): Builtin("load") {}
@@ -97,8 +192,52 @@ public:
       std::string fileName;
       ozVSGet(vm, fileNameVS, fileNameSize, fileName);
 
-      std::ifstream file(fileName, std::ios_base::binary);
-      result = unpickle(vm, file);
+      // Regular files are read at once, and closed before unpickling. Others,
+      // such as pipes, have no size and are unpickled as they are read.
+      std::vector<unsigned char> buffer;
+      int errnum = 0;
+      bool streamed = false;
+      {
+        struct stat status;
+        bool found = (stat(fileName.c_str(), &status) == 0);
+
+        if (found && S_ISDIR(status.st_mode)) {
+          errnum = EISDIR;
+        } else {
+          std::ifstream file(fileName, std::ios_base::binary);
+          if (!file.is_open()) {
+            errnum = (errno != 0) ? errno : ENOENT;
+          } else if (found && S_ISREG(status.st_mode)) {
+            buffer.resize((size_t) status.st_size);
+            file.read(reinterpret_cast<char*>(buffer.data()), buffer.size());
+            buffer.resize((size_t) file.gcount());
+          } else {
+            MOZART_TRY(vm) {
+              result = unpickle(vm, file);
+            } MOZART_CATCH(vm, kind, node) {
+              // The raise skips the destructors of file and fileName
+              file.close();
+              std::string().swap(fileName);
+              MOZART_RETHROW(vm);
+            } MOZART_ENDTRY(vm);
+            streamed = true;
+          }
+        }
+      }
+      std::string().swap(fileName);
+
+      if (errnum != 0)
+        raisePickleFileError(vm, "open", errnum);
+      if (streamed)
+        return;
+
+      MOZART_TRY(vm) {
+        result = unpickleFile(vm, buffer.data(), buffer.size());
+      } MOZART_CATCH(vm, kind, node) {
+        // The raise skips the destructor of buffer
+        std::vector<unsigned char>().swap(buffer);
+        MOZART_RETHROW(vm);
+      } MOZART_ENDTRY(vm);
     }
   };
 };
@@ -0,0 +1,413 @@
+// Copyright © 2014, Université catholique de Louvain
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// *  Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// *  Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MOZART_MODPROFILE_H
+#define MOZART_MODPROFILE_H
+
+#include "../mozartcore.hh"
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+
+#ifndef MOZART_GENERATOR
+
+namespace mozart {
+
+namespace builtins {
+
+////////////////////
+// Profile module //
+////////////////////
+
+/**
+ * Write a report to the file named by fileNameVS with write(std::ostream&)
+ * Reports that cannot be written raise the same error as the OS module. The
+ * file and its name are freed before, since the raise skips destructors.
+ */
+template <class F>
+void saveReport(VM vm, RichNode fileNameVS, std::ios_base::openmode mode,
+                const F& write) {
+  const char* function = nullptr;
+  int errnum = 0;
+  {
+    size_t fileNameSize = ozVSLengthForBuffer(vm, fileNameVS);
+    std::string fileName;
+    ozVSGet(vm, fileNameVS, fileNameSize, fileName);
+
+    std::ofstream file(fileName, mode);
+    if (!file) {
+      function = "open";
+      errnum = errno;
+    } else {
+      write(file);
+      file.close();
+      if (!file) {
+        function = "write";
+        errnum = errno;
+      }
+    }
+  }
+
+  if (function != nullptr) {
+    raiseSystem(vm, "os", "os", function, (nativeint) errnum,
+                vm->getAtom(std::strerror(errnum)));
+  }
+}
+
+class ModProfile: public Module {
+public:
+  ModProfile(): Module("Profile") {}
+
+  class Start: public Builtin<Start> {
+  public:
+    Start(): Builtin("start") {}
+
+    static void call(VM vm) {
+      vm->getProfiler().start();
+    }
+  };
+
+  class Stop: public Builtin<Stop> {
+  public:
+    Stop(): Builtin("stop") {}
+
+    static void call(VM vm) {
+      vm->getProfiler().stop();
+    }
+  };
+
+  class IsRunning: public Builtin<IsRunning> {
+  public:
+    IsRunning(): Builtin("isRunning") {}
+
+    static void call(VM vm, Out result) {
+      result = build(vm, vm->getProfiler().isRunning());
+    }
+  };
+
+  class GetSampleCount: public Builtin<GetSampleCount> {
+  public:
+    GetSampleCount(): Builtin("getSampleCount") {}
+
+    static void call(VM vm, Out result) {
+      result = build(vm, vm->getProfiler().getSampleCount());
+    }
+  };
+
+  class GetCollapsedStacks: public Builtin<GetCollapsedStacks> {
+  public:
+    GetCollapsedStacks(): Builtin("getCollapsedStacks") {}
+
+    static void call(VM vm, Out result) {
+      std::string stacks = vm->getProfiler().getCollapsedStacks();
+      result = String::build(vm,
+                             newLString(vm, stacks.data(), stacks.size()));
+    }
+  };
+
+  class GetProcedures: public Builtin<GetProcedures> {
+  public:
+    GetProcedures(): Builtin("getProcedures") {}
+
+    static void call(VM vm, Out result) {
+      OzListBuilder builder(vm);
+
+      for (auto& procedure : vm->getProfiler().getProcedureCounts()) {
+        auto& name = procedure.first;
+        builder.push_back(vm, buildRecord(
+          vm, buildArity(vm, "procedure", "name", "self", "total"),
+          String::build(vm, newLString(vm, name.data(), name.size())),
+          procedure.second.self, procedure.second.total));
+      }
+
+      result = builder.get(vm);
+    }
+  };
+
+  class IsCountingOpcodes: public Builtin<IsCountingOpcodes> {
+  public:
+    IsCountingOpcodes(): Builtin("isCountingOpcodes") {}
+
+    static void call(VM vm, Out result) {
+      result = build(vm, OpcodeStats::isEnabled());
+    }
+  };
+
+  class GetOpcodeCounts: public Builtin<GetOpcodeCounts> {
+  public:
+    GetOpcodeCounts(): Builtin("getOpcodeCounts") {}
+
+    static void call(VM vm, Out result) {
+      auto& stats = vm->getOpcodeStats();
+      OzListBuilder builder(vm);
+
+      for (size_t op = 0; op < OpcodeStats::opcodeCount; op++) {
+        const char* name = OpcodeStats::getOpcodeName((OpCode) op);
+        auto count = stats.getCount((OpCode) op);
+        if (count != 0 && name != nullptr)
+          builder.push_back(vm, buildSharp(vm, vm->getAtom(name),
+                                           (nativeint) count));
+      }
+
+      result = builder.get(vm);
+    }
+  };
+
+  class GetOpcodePairCounts: public Builtin<GetOpcodePairCounts> {
+  public:
+    GetOpcodePairCounts(): Builtin("getOpcodePairCounts") {}
+
+    static void call(VM vm, Out result) {
+      auto& stats = vm->getOpcodeStats();
+      OzListBuilder builder(vm);
+
+      if (OpcodeStats::isEnabled()) {
+        for (size_t first = 0; first < OpcodeStats::opcodeCount; first++) {
+          const char* firstName = OpcodeStats::getOpcodeName((OpCode) first);
+          if (firstName == nullptr)
+            continue;
+
+          for (size_t second = 0; second < OpcodeStats::opcodeCount;
+               second++) {
+            const char* secondName =
+              OpcodeStats::getOpcodeName((OpCode) second);
+            auto count = stats.getPairCount((OpCode) first, (OpCode) second);
+            if (count != 0 && secondName != nullptr)
+              builder.push_back(vm, buildSharp(
+                vm, vm->getAtom(firstName), vm->getAtom(secondName),
+                (nativeint) count));
+          }
+        }
+      }
+
+      result = builder.get(vm);
+    }
+  };
+
+  class ResetOpcodeCounts: public Builtin<ResetOpcodeCounts> {
+  public:
+    ResetOpcodeCounts(): Builtin("resetOpcodeCounts") {}
+
+    static void call(VM vm) {
+      vm->getOpcodeStats().reset();
+    }
+  };
+
+  class SaveOpcodeCounts: public Builtin<SaveOpcodeCounts> {
+  public:
+    SaveOpcodeCounts(): Builtin("saveOpcodeCounts") {}
+
+    static void call(VM vm, In fileNameVS) {
+      saveReport(vm, fileNameVS, std::ios_base::out,
+        [vm] (std::ostream& out) {
+          vm->getOpcodeStats().dump(out);
+        });
+    }
+  };
+
+  class GetHeapCensus: public Builtin<GetHeapCensus> {
+  public:
+    GetHeapCensus(): Builtin("getHeapCensus") {}
+
+    static void call(VM vm, Out result) {
+      OzListBuilder builder(vm);
+
+      for (auto& entry : vm->getHeapCensus().getSortedEntries()) {
+        builder.push_back(vm, buildRecord(
+          vm, buildArity(vm, "entry", "bytes", "count", "kind"),
+          entry.second.bytes, entry.second.count,
+          vm->getAtom(entry.first.size(), entry.first.data())));
+      }
+
+      result = builder.get(vm);
+    }
+  };
+
+  class SaveHeapCensus: public Builtin<SaveHeapCensus> {
+  public:
+    SaveHeapCensus(): Builtin("saveHeapCensus") {}
+
+    static void call(VM vm, In fileNameVS) {
+      saveReport(vm, fileNameVS, std::ios_base::out,
+        [vm] (std::ostream& out) {
+          vm->getHeapCensus().dump(out);
+        });
+    }
+  };
+
+  class StartAllocations: public Builtin<StartAllocations> {
+  public:
+    StartAllocations(): Builtin("startAllocations") {}
+
+    static void call(VM vm, In interval) {
+      auto intInterval = getArgument<nativeint>(vm, interval, "integer");
+      if (intInterval <= 0)
+        raiseTypeError(vm, "positive integer", interval);
+
+      vm->getAllocationProfiler().start(vm, (size_t) intInterval);
+    }
+  };
+
+  class StopAllocations: public Builtin<StopAllocations> {
+  public:
+    StopAllocations(): Builtin("stopAllocations") {}
+
+    static void call(VM vm) {
+      vm->getAllocationProfiler().stop(vm);
+    }
+  };
+
+  class GetAllocationSampleCount: public Builtin<GetAllocationSampleCount> {
+  public:
+    GetAllocationSampleCount(): Builtin("getAllocationSampleCount") {}
+
+    static void call(VM vm, Out result) {
+      result = build(vm, vm->getAllocationProfiler().getSampleCount());
+    }
+  };
+
+  class GetAllocationProfile: public Builtin<GetAllocationProfile> {
+  public:
+    GetAllocationProfile(): Builtin("getAllocationProfile") {}
+
+    static void call(VM vm, Out result) {
+      std::string profile = vm->getAllocationProfiler().getPprofProfile(vm);
+      auto bytes = newLString(vm,
+        reinterpret_cast<const unsigned char*>(profile.data()),
+        profile.size());
+      result = ByteString::build(vm, bytes);
+    }
+  };
+
+  class SaveAllocationProfile: public Builtin<SaveAllocationProfile> {
+  public:
+    SaveAllocationProfile(): Builtin("saveAllocationProfile") {}
+
+    static void call(VM vm, In fileNameVS) {
+      saveReport(vm, fileNameVS, std::ios_base::out | std::ios_base::binary,
+        [vm] (std::ostream& out) {
+          std::string profile =
+            vm->getAllocationProfiler().getPprofProfile(vm);
+          out.write(profile.data(), profile.size());
+        });
+    }
+  };
+
+  class StartTrace: public Builtin<StartTrace> {
+  public:
+    StartTrace(): Builtin("startTrace") {}
+
+    static void call(VM vm, In capacity) {
+      auto intCapacity = getArgument<nativeint>(vm, capacity, "integer");
+      if (intCapacity <= 0)
+        raiseTypeError(vm, "positive integer", capacity);
+
+      vm->getTracer().start((size_t) intCapacity);
+    }
+  };
+
+  class StopTrace: public Builtin<StopTrace> {
+  public:
+    StopTrace(): Builtin("stopTrace") {}
+
+    static void call(VM vm) {
+      vm->getTracer().stop();
+    }
+  };
+
+  class SaveTrace: public Builtin<SaveTrace> {
+  public:
+    SaveTrace(): Builtin("saveTrace") {}
+
+    static void call(VM vm, In fileNameVS) {
+      saveReport(vm, fileNameVS, std::ios_base::out,
+        [vm] (std::ostream& out) {
+          vm->getTracer().dumpChromeTrace(out);
+        });
+    }
+  };
+
+  class StartBuiltinStats: public Builtin<StartBuiltinStats> {
+  public:
+    StartBuiltinStats(): Builtin("startBuiltinStats") {}
+
+    static void call(VM vm) {
+      vm->getBuiltinStats().start();
+    }
+  };
+
+  class StopBuiltinStats: public Builtin<StopBuiltinStats> {
+  public:
+    StopBuiltinStats(): Builtin("stopBuiltinStats") {}
+
+    static void call(VM vm) {
+      vm->getBuiltinStats().stop();
+    }
+  };
+
+  class GetBuiltinStats: public Builtin<GetBuiltinStats> {
+  public:
+    GetBuiltinStats(): Builtin("getBuiltinStats") {}
+
+    static void call(VM vm, Out result) {
+      // Times are in nanoseconds, the most expensive builtins come first
+      OzListBuilder builder(vm);
+
+      for (auto& line : vm->getBuiltinStats().getReport()) {
+        auto& name = line.first;
+        auto& entry = line.second;
+        builder.push_back(vm, buildRecord(
+          vm, buildArity(vm, "builtin", "calls", "name", "raised",
+                         "suspended", "time"),
+          (nativeint) entry.calls,
+          String::build(vm, newLString(vm, name.data(), name.size())),
+          (nativeint) entry.raised, (nativeint) entry.suspended,
+          (nativeint) entry.time));
+      }
+
+      result = builder.get(vm);
+    }
+  };
+
+  class SaveBuiltinStats: public Builtin<SaveBuiltinStats> {
+  public:
+    SaveBuiltinStats(): Builtin("saveBuiltinStats") {}
+
+    static void call(VM vm, In fileNameVS) {
+      saveReport(vm, fileNameVS, std::ios_base::out,
+        [vm] (std::ostream& out) {
+          vm->getBuiltinStats().dump(out);
+        });
+    }
+  };
+};
+
+}
+
+}
+
+#endif // MOZART_GENERATOR
+
+#endif // MOZART_MODPROFILE_H
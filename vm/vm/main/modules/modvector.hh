@@ -0,0 +1,147 @@
+// Copyright © 2014, Université catholique de Louvain
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// *  Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// *  Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MOZART_MODVECTOR_H
+#define MOZART_MODVECTOR_H
+
+#include "../mozartcore.hh"
+
+#ifndef MOZART_GENERATOR
+
+namespace mozart {
+
+namespace builtins {
+
+///////////////////
+// Vector module //
+///////////////////
+
+class ModVector: public Module {
+public:
+  ModVector(): Module("Vector") {}
+
+  static TypedRichNode<Vector> getVector(VM vm, RichNode vector) {
+    if (vector.is<Vector>())
+      return vector.as<Vector>();
+    else if (vector.isTransient())
+      waitFor(vm, vector);
+    else
+      raiseTypeError(vm, "Vector", vector);
+  }
+
+  class New: public Builtin<New> {
+  public:
+    New(): Builtin("new") {}
+
+    static void call(VM vm, In capacity, Out result) {
+      auto intCapacity = getArgument<nativeint>(vm, capacity, "integer");
+      if (intCapacity < 0)
+        raise(vm, "negativeVectorCapacity", capacity);
+
+      result = Vector::build(vm, (size_t) intCapacity);
+    }
+  };
+
+  class Is: public Builtin<Is> {
+  public:
+    Is(): Builtin("is") {}
+
+    static void call(VM vm, In value, Out result) {
+      if (value.isTransient())
+        waitFor(vm, value);
+      result = build(vm, value.is<Vector>());
+    }
+  };
+
+  class Size: public Builtin<Size> {
+  public:
+    Size(): Builtin("size") {}
+
+    static void call(VM vm, In vector, Out result) {
+      result = getVector(vm, vector).size(vm);
+    }
+  };
+
+  class Get: public Builtin<Get> {
+  public:
+    Get(): Builtin("get") {}
+
+    static void call(VM vm, In vector, In index, Out result) {
+      result = getVector(vm, vector).get(vm, index);
+    }
+  };
+
+  class Put: public Builtin<Put> {
+  public:
+    Put(): Builtin("put") {}
+
+    static void call(VM vm, In vector, In index, In value) {
+      getVector(vm, vector).put(vm, index, value);
+    }
+  };
+
+  class Push: public Builtin<Push> {
+  public:
+    Push(): Builtin("push") {}
+
+    static void call(VM vm, In vector, In value) {
+      getVector(vm, vector).push(vm, value);
+    }
+  };
+
+  class Pop: public Builtin<Pop> {
+  public:
+    Pop(): Builtin("pop") {}
+
+    static void call(VM vm, In vector, Out result) {
+      result = getVector(vm, vector).pop(vm);
+    }
+  };
+
+  class ToTuple: public Builtin<ToTuple> {
+  public:
+    ToTuple(): Builtin("toTuple") {}
+
+    static void call(VM vm, In vector, In label, Out result) {
+      result = getVector(vm, vector).toTuple(vm, label);
+    }
+  };
+
+  class ToList: public Builtin<ToList> {
+  public:
+    ToList(): Builtin("toList") {}
+
+    static void call(VM vm, In vector, Out result) {
+      result = getVector(vm, vector).toList(vm);
+    }
+  };
+};
+
+}
+
+}
+
+#endif // MOZART_GENERATOR
+
+#endif // MOZART_MODVECTOR_H
@@ -42,6 +42,7 @@
 #include "gcollect-decl.hh"
 #include "sclone-decl.hh"
 #include "unify-decl.hh"
+#include "cpufeatures-decl.hh"
 #include "lstring-decl.hh"
 #include "coders-decl.hh"
 #include "utf-decl.hh"
@@ -0,0 +1,99 @@
+// Copyright © 2014, Université catholique de Louvain
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// *  Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// *  Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MOZART_OPCODESTATS_DECL_H
+#define MOZART_OPCODESTATS_DECL_H
+
+#include "core-forward-decl.hh"
+
+#include "opcodes.hh"
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace mozart {
+
+/////////////////
+// OpcodeStats //
+/////////////////
+
+/**
+ * Execution counters of the opcodes and of the pairs of consecutive opcodes
+ * The emulator only feeds them in builds configured with MOZART_OPCODE_STATS,
+ * so that they cost nothing in normal builds.
+ */
+class OpcodeStats {
+public:
+  static constexpr size_t opcodeCount = 0x100;
+
+  /** Whether the emulator was built to count the opcodes */
+  static bool isEnabled();
+
+  /** Name of an opcode, or nullptr if it is not a valid opcode */
+  static const char* getOpcodeName(OpCode opcode);
+
+public:
+  OpcodeStats();
+
+  void record(OpCode opcode) {
+    if (opcode >= opcodeCount)
+      return;
+
+    _counts[opcode]++;
+    if (_previous < opcodeCount && !_pairs.empty())
+      _pairs[_previous * opcodeCount + opcode]++;
+    _previous = opcode;
+  }
+
+  /** Forget the previous opcode, so that no pair spans two runs */
+  void startRun() {
+    _previous = opcodeCount;
+  }
+
+  void reset();
+
+  std::uint64_t getCount(OpCode opcode) {
+    return _counts[opcode];
+  }
+
+  std::uint64_t getPairCount(OpCode first, OpCode second) {
+    return _pairs.empty() ? 0 : _pairs[first * opcodeCount + second];
+  }
+
+  /**
+   * Write the non-zero counters, one per line, as "op NAME COUNT" and
+   * "pair FIRST SECOND COUNT"
+   */
+  void dump(std::ostream& output);
+
+private:
+  std::vector<std::uint64_t> _counts;
+  std::vector<std::uint64_t> _pairs; // empty unless enabled
+  size_t _previous;
+};
+
+}
+
+#endif // MOZART_OPCODESTATS_DECL_H
@@ -0,0 +1,175 @@
+// Copyright © 2014, Université catholique de Louvain
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// *  Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// *  Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "mozart.hh"
+
+namespace mozart {
+
+/////////////////
+// OpcodeStats //
+/////////////////
+
+constexpr size_t OpcodeStats::opcodeCount;
+
+bool OpcodeStats::isEnabled() {
+#ifdef MOZART_OPCODE_STATS
+  return true;
+#else
+  return false;
+#endif
+}
+
+const char* OpcodeStats::getOpcodeName(OpCode opcode) {
+  switch (opcode) {
+    case OpSkip: return "Skip";
+    case OpMoveXX: return "MoveXX";
+    case OpMoveXY: return "MoveXY";
+    case OpMoveYX: return "MoveYX";
+    case OpMoveYY: return "MoveYY";
+    case OpMoveGX: return "MoveGX";
+    case OpMoveGY: return "MoveGY";
+    case OpMoveKX: return "MoveKX";
+    case OpMoveKY: return "MoveKY";
+    case OpMoveMoveXYXY: return "MoveMoveXYXY";
+    case OpMoveMoveYXYX: return "MoveMoveYXYX";
+    case OpMoveMoveYXXY: return "MoveMoveYXXY";
+    case OpMoveMoveXYYX: return "MoveMoveXYYX";
+    case OpAllocateY: return "AllocateY";
+    case OpCreateVarX: return "CreateVarX";
+    case OpCreateVarY: return "CreateVarY";
+    case OpCreateVarMoveX: return "CreateVarMoveX";
+    case OpCreateVarMoveY: return "CreateVarMoveY";
+    case OpSetupExceptionHandler: return "SetupExceptionHandler";
+    case OpPopExceptionHandler: return "PopExceptionHandler";
+    case OpCallBuiltin0: return "CallBuiltin0";
+    case OpCallBuiltin1: return "CallBuiltin1";
+    case OpCallBuiltin2: return "CallBuiltin2";
+    case OpCallBuiltin3: return "CallBuiltin3";
+    case OpCallBuiltin4: return "CallBuiltin4";
+    case OpCallBuiltin5: return "CallBuiltin5";
+    case OpCallBuiltinN: return "CallBuiltinN";
+    case OpCallX: return "CallX";
+    case OpCallY: return "CallY";
+    case OpCallG: return "CallG";
+    case OpCallK: return "CallK";
+    case OpTailCallX: return "TailCallX";
+    case OpTailCallY: return "TailCallY";
+    case OpTailCallG: return "TailCallG";
+    case OpTailCallK: return "TailCallK";
+    case OpSendMsgX: return "SendMsgX";
+    case OpSendMsgY: return "SendMsgY";
+    case OpSendMsgG: return "SendMsgG";
+    case OpSendMsgK: return "SendMsgK";
+    case OpTailSendMsgX: return "TailSendMsgX";
+    case OpTailSendMsgY: return "TailSendMsgY";
+    case OpTailSendMsgG: return "TailSendMsgG";
+    case OpTailSendMsgK: return "TailSendMsgK";
+    case OpReturn: return "Return";
+    case OpBranch: return "Branch";
+    case OpBranchBackward: return "BranchBackward";
+    case OpCondBranch: return "CondBranch";
+    case OpCondBranchFB: return "CondBranchFB";
+    case OpCondBranchBF: return "CondBranchBF";
+    case OpCondBranchBB: return "CondBranchBB";
+    case OpPatternMatchX: return "PatternMatchX";
+    case OpPatternMatchY: return "PatternMatchY";
+    case OpPatternMatchG: return "PatternMatchG";
+    case OpUnifyXX: return "UnifyXX";
+    case OpUnifyXY: return "UnifyXY";
+    case OpUnifyXG: return "UnifyXG";
+    case OpUnifyXK: return "UnifyXK";
+    case OpUnifyYY: return "UnifyYY";
+    case OpUnifyYG: return "UnifyYG";
+    case OpUnifyYK: return "UnifyYK";
+    case OpUnifyGG: return "UnifyGG";
+    case OpUnifyGK: return "UnifyGK";
+    case OpUnifyKK: return "UnifyKK";
+    case OpCreateAbstractionStoreX: return "CreateAbstractionStoreX";
+    case OpCreateConsStoreX: return "CreateConsStoreX";
+    case OpCreateTupleStoreX: return "CreateTupleStoreX";
+    case OpCreateRecordStoreX: return "CreateRecordStoreX";
+    case OpCreateAbstractionStoreY: return "CreateAbstractionStoreY";
+    case OpCreateConsStoreY: return "CreateConsStoreY";
+    case OpCreateTupleStoreY: return "CreateTupleStoreY";
+    case OpCreateRecordStoreY: return "CreateRecordStoreY";
+    case OpCreateAbstractionUnifyX: return "CreateAbstractionUnifyX";
+    case OpCreateConsUnifyX: return "CreateConsUnifyX";
+    case OpCreateTupleUnifyX: return "CreateTupleUnifyX";
+    case OpCreateRecordUnifyX: return "CreateRecordUnifyX";
+    case OpCreateAbstractionUnifyY: return "CreateAbstractionUnifyY";
+    case OpCreateConsUnifyY: return "CreateConsUnifyY";
+    case OpCreateTupleUnifyY: return "CreateTupleUnifyY";
+    case OpCreateRecordUnifyY: return "CreateRecordUnifyY";
+    case OpCreateAbstractionUnifyG: return "CreateAbstractionUnifyG";
+    case OpCreateConsUnifyG: return "CreateConsUnifyG";
+    case OpCreateTupleUnifyG: return "CreateTupleUnifyG";
+    case OpCreateRecordUnifyG: return "CreateRecordUnifyG";
+    case OpCreateAbstractionUnifyK: return "CreateAbstractionUnifyK";
+    case OpCreateConsUnifyK: return "CreateConsUnifyK";
+    case OpCreateTupleUnifyK: return "CreateTupleUnifyK";
+    case OpCreateRecordUnifyK: return "CreateRecordUnifyK";
+    case OpInlineEqualsInteger: return "InlineEqualsInteger";
+    case OpInlineAdd: return "InlineAdd";
+    case OpInlineSubtract: return "InlineSubtract";
+    case OpInlinePlus1: return "InlinePlus1";
+    case OpInlineMinus1: return "InlineMinus1";
+    case OpInlineGetClass: return "InlineGetClass";
+    case OpDebugEntry: return "DebugEntry";
+    case OpDebugExit: return "DebugExit";
+    case OpLocalVarname: return "LocalVarname";
+    case OpGlobalVarname: return "GlobalVarname";
+    case OpClearY: return "ClearY";
+    default: return nullptr;
+  }
+}
+
+OpcodeStats::OpcodeStats():
+  _counts(opcodeCount, 0),
+  _pairs(isEnabled() ? opcodeCount * opcodeCount : 0, 0),
+  _previous(opcodeCount) {
+}
+
+void OpcodeStats::reset() {
+  std::fill(_counts.begin(), _counts.end(), 0);
+  std::fill(_pairs.begin(), _pairs.end(), 0);
+  _previous = opcodeCount;
+}
+
+void OpcodeStats::dump(std::ostream& output) {
+  // Invalid opcodes are counted before the emulator rejects them, skip them
+  for (size_t op = 0; op < opcodeCount; op++) {
+    const char* name = getOpcodeName((OpCode) op);
+    if (_counts[op] != 0 && name != nullptr)
+      output << "op " << name << " " << _counts[op] << "\n";
+  }
+
+  for (size_t i = 0; i < _pairs.size(); i++) {
+    const char* first = getOpcodeName((OpCode) (i / opcodeCount));
+    const char* second = getOpcodeName((OpCode) (i % opcodeCount));
+    if (_pairs[i] != 0 && first != nullptr && second != nullptr)
+      output << "pair " << first << " " << second << " " << _pairs[i] << "\n";
+  }
+}
+
+}
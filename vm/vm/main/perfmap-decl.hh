@@ -0,0 +1,109 @@
+// Copyright © 2014, Université catholique de Louvain
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// *  Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// *  Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MOZART_PERFMAP_DECL_H
+#define MOZART_PERFMAP_DECL_H
+
+#include "core-forward-decl.hh"
+
+#include <string>
+#include <unordered_map>
+
+// Trampolines are hand-written machine code, for the platforms of perf
+#if defined(__linux__) && (defined(__x86_64__) || defined(__aarch64__))
+#define MOZART_PERF_TRAMPOLINES
+#endif
+
+namespace mozart {
+
+/////////////
+// PerfMap //
+/////////////
+
+/**
+ * Native trampolines of Oz procedures for the Linux perf profiler
+ * Bytecode is not native code, so perf sees all the time spent in Oz as
+ * Thread::run. When enabled, the emulator is entered through a small native
+ * trampoline that is specific to the running procedure, and leaves it each
+ * time it calls or returns to another procedure. The address range of each
+ * trampoline is written, with the name of its procedure, to
+ * /tmp/perf-<pid>.map, where perf looks for the symbols of JIT code.
+ *
+ * The trampolines are never freed, not even with their VM, so that the map
+ * stays valid until the end of the process. Their lookup is cached by code
+ * block, and the cache is cleared at each GC since code blocks move.
+ */
+class PerfMap {
+public:
+  typedef void (*EmulateFunction)(void* thread);
+  typedef void (*Trampoline)(void* thread, EmulateFunction emulate);
+
+  PerfMap(): _enabled(false), _free(nullptr), _freeCount(0) {}
+
+  /** Are trampolines available on this platform? */
+  static bool isSupported();
+
+  bool isEnabled() {
+    return _enabled;
+  }
+
+  /** Enable the trampolines, if they are supported */
+  void setEnabled(bool value) {
+    _enabled = value && isSupported();
+  }
+
+  /**
+   * Write the map of the process to another file than /tmp/perf-<pid>.map,
+   * such as a file of a test. Has no effect once the first trampoline of the
+   * process has been mapped.
+   */
+  static void setMapFileName(const std::string& fileName);
+
+  /** Trampoline of a procedure, created and mapped on first use */
+  Trampoline getTrampoline(VM vm, RichNode abstraction);
+
+  /** Number of trampolines created by this VM */
+  size_t getTrampolineCount() {
+    return _byName.size();
+  }
+
+  void beforeGC() {
+    _byCodeBlock.clear();
+  }
+private:
+  Trampoline newTrampoline(const std::string& name);
+
+  bool _enabled;
+
+  std::unordered_map<const void*, Trampoline> _byCodeBlock;
+  std::unordered_map<std::string, Trampoline> _byName;
+
+  // Trampolines not handed out yet in the last executable chunk
+  unsigned char* _free;
+  size_t _freeCount;
+};
+
+}
+
+#endif // MOZART_PERFMAP_DECL_H
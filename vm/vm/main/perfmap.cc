@@ -0,0 +1,189 @@
+// Copyright © 2014, Université catholique de Louvain
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// *  Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// *  Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "mozart.hh"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+
+#ifdef MOZART_PERF_TRAMPOLINES
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace mozart {
+
+#ifdef MOZART_PERF_TRAMPOLINES
+
+namespace {
+  /**
+   * Code of a trampoline(thread, emulate): it sets up a frame, so that perf
+   * can unwind through it, and calls emulate(thread)
+   */
+#if defined(__x86_64__)
+  const unsigned char trampolineCode[] = {
+    0x55,             // push %rbp
+    0x48, 0x89, 0xe5, // mov %rsp, %rbp
+    0xff, 0xd6,       // call *%rsi
+    0x5d,             // pop %rbp
+    0xc3              // ret
+  };
+  const size_t trampolineSize = 16;
+#elif defined(__aarch64__)
+  const std::uint32_t trampolineCode[] = {
+    0xa9bf7bfd, // stp x29, x30, [sp, #-16]!
+    0x910003fd, // mov x29, sp
+    0xd63f0020, // blr x1
+    0xa8c17bfd, // ldp x29, x30, [sp], #16
+    0xd65f03c0  // ret
+  };
+  const size_t trampolineSize = 32;
+#endif
+
+  const size_t trampolinesPerChunk = 4096;
+  const size_t chunkSize = trampolinesPerChunk * trampolineSize;
+
+  // The map file is shared by all the VMs of the process
+  std::mutex perfMapMutex;
+  std::FILE* perfMapFile = nullptr;
+  std::string perfMapFileName; // empty for the file where perf looks
+
+  void writePerfMapEntry(const void* start, size_t size, std::string name) {
+    std::replace(name.begin(), name.end(), '\n', ' ');
+
+    std::lock_guard<std::mutex> lock(perfMapMutex);
+
+    if (perfMapFile == nullptr) {
+      if (perfMapFileName.empty()) {
+        char fileName[64];
+        std::snprintf(fileName, sizeof(fileName), "/tmp/perf-%ld.map",
+                      (long) getpid());
+        perfMapFileName = fileName;
+      }
+      perfMapFile = std::fopen(perfMapFileName.c_str(), "w");
+      if (perfMapFile == nullptr)
+        return;
+    }
+
+    std::fprintf(perfMapFile, "%lx %lx %s\n", (unsigned long) start,
+                 (unsigned long) size, name.c_str());
+    std::fflush(perfMapFile);
+  }
+}
+
+#endif // MOZART_PERF_TRAMPOLINES
+
+/////////////
+// PerfMap //
+/////////////
+
+bool PerfMap::isSupported() {
+#ifdef MOZART_PERF_TRAMPOLINES
+  return true;
+#else
+  return false;
+#endif
+}
+
+void PerfMap::setMapFileName(const std::string& fileName) {
+#ifdef MOZART_PERF_TRAMPOLINES
+  std::lock_guard<std::mutex> lock(perfMapMutex);
+  if (perfMapFile == nullptr)
+    perfMapFileName = fileName;
+#endif
+}
+
+PerfMap::Trampoline PerfMap::getTrampoline(VM vm, RichNode abstraction) {
+  const void* codeBlock = nullptr;
+  if (abstraction.is<Abstraction>()) {
+    RichNode body = *abstraction.as<Abstraction>().getBody();
+    if (body.is<CodeArea>())
+      codeBlock = body.as<CodeArea>().getCodeBlock(vm);
+  }
+
+  if (codeBlock != nullptr) {
+    auto iter = _byCodeBlock.find(codeBlock);
+    if (iter != _byCodeBlock.end())
+      return iter->second;
+  }
+
+  // Procedures with the same name share their trampoline, as perf would
+  // merge their symbols anyway
+  std::string name = "oz::" + Profiler::getFrameName(vm, abstraction);
+
+  Trampoline trampoline;
+  auto iter = _byName.find(name);
+  if (iter != _byName.end()) {
+    trampoline = iter->second;
+  } else {
+    trampoline = newTrampoline(name);
+    if (trampoline == nullptr)
+      return nullptr;
+    _byName[name] = trampoline;
+  }
+
+  if (codeBlock != nullptr)
+    _byCodeBlock[codeBlock] = trampoline;
+  return trampoline;
+}
+
+PerfMap::Trampoline PerfMap::newTrampoline(const std::string& name) {
+#ifdef MOZART_PERF_TRAMPOLINES
+  if (_freeCount == 0) {
+    // Fill a whole chunk at once, so that it is made executable only once
+    void* chunk = mmap(nullptr, chunkSize, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (chunk == MAP_FAILED)
+      return nullptr;
+
+    auto bytes = static_cast<unsigned char*>(chunk);
+    for (size_t i = 0; i < trampolinesPerChunk; i++)
+      std::memcpy(bytes + i * trampolineSize, trampolineCode,
+                  sizeof(trampolineCode));
+    __builtin___clear_cache(reinterpret_cast<char*>(bytes),
+                            reinterpret_cast<char*>(bytes + chunkSize));
+
+    if (mprotect(chunk, chunkSize, PROT_READ | PROT_EXEC) != 0) {
+      munmap(chunk, chunkSize);
+      return nullptr;
+    }
+
+    _free = bytes;
+    _freeCount = trampolinesPerChunk;
+  }
+
+  unsigned char* code = _free;
+  _free += trampolineSize;
+  _freeCount--;
+
+  writePerfMapEntry(code, sizeof(trampolineCode), name);
+  return reinterpret_cast<Trampoline>(code);
+#else
+  return nullptr;
+#endif
+}
+
+}
@@ -0,0 +1,252 @@
+// Copyright © 2014, Université catholique de Louvain
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// *  Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// *  Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MOZART_PERSISTENTMAP_DECL_H
+#define MOZART_PERSISTENTMAP_DECL_H
+
+#include "mozartcore-decl.hh"
+
+namespace mozart {
+
+///////////////////////
+// PersistentMapNode //
+///////////////////////
+
+#ifndef MOZART_GENERATOR
+#include "PersistentMapNode-implem-decl.hh"
+#endif
+
+/**
+ * Immutable node of the hash array mapped trie behind PersistentMap
+ * The elements array holds first the key/value pairs of the entries stored
+ * in this node, then the child nodes, both in the order of their bit in
+ * _dataMap and _nodeMap respectively.
+ * A node whose both bitmaps are zero is a collision node: it holds only
+ * entries, whose keys all have the same hash.
+ */
+class PersistentMapNode: public DataType<PersistentMapNode>,
+  StoredWithArrayOf<StableNode> {
+public:
+  typedef std::uint32_t Bitmap;
+
+  static atom_t getTypeAtom(VM vm) {
+    return vm->getAtom("persistentMapNode");
+  }
+
+  inline
+  PersistentMapNode(VM vm, size_t width, Bitmap dataMap, Bitmap nodeMap);
+
+  inline
+  PersistentMapNode(VM vm, size_t width, GR gr, PersistentMapNode& from);
+
+public:
+  // Requirement for StoredWithArrayOf
+  size_t getArraySizeImpl() {
+    return _width;
+  }
+
+public:
+  Bitmap getDataMap() {
+    return _dataMap;
+  }
+
+  Bitmap getNodeMap() {
+    return _nodeMap;
+  }
+
+  bool isCollision() {
+    return (_dataMap == 0) && (_nodeMap == 0);
+  }
+
+  size_t getEntryCount() {
+    return isCollision() ? _width / 2 : __builtin_popcount(_dataMap);
+  }
+
+  size_t dataIndex(Bitmap bit) {
+    return __builtin_popcount(_dataMap & (bit - 1));
+  }
+
+  size_t nodeIndex(Bitmap bit) {
+    return 2 * __builtin_popcount(_dataMap) +
+      __builtin_popcount(_nodeMap & (bit - 1));
+  }
+
+public:
+  // Miscellaneous
+
+  void printReprToStream(VM vm, std::ostream& out, int depth, int width) {
+    out << "<PersistentMapNode>";
+  }
+
+private:
+  size_t _width;
+  Bitmap _dataMap;
+  Bitmap _nodeMap;
+};
+
+#ifndef MOZART_GENERATOR
+#include "PersistentMapNode-implem-decl-after.hh"
+#endif
+
+///////////////////
+// PersistentMap //
+///////////////////
+
+#ifndef MOZART_GENERATOR
+#include "PersistentMap-implem-decl.hh"
+#endif
+
+/**
+ * Immutable map from features to values (hash array mapped trie)
+ * Updates return a new map that shares all the untouched nodes of the trie
+ * with the original one, so that put and remove cost O(log32 n).
+ */
+class PersistentMap: public DataType<PersistentMap>, WithStructuralBehavior {
+public:
+  typedef std::uint32_t Hash;
+  typedef PersistentMapNode::Bitmap Bitmap;
+
+  static constexpr size_t bitsPerLevel = 5;
+  static constexpr size_t hashBits = 32;
+
+  static atom_t getTypeAtom(VM vm) {
+    return vm->coreatoms.persistentMap;
+  }
+
+  PersistentMap(VM vm): _size(0), _root(nullptr) {}
+
+  inline
+  PersistentMap(VM vm, size_t size, UnstableNode&& root);
+
+  inline
+  PersistentMap(VM vm, GR gr, PersistentMap& from);
+
+public:
+  size_t getSize() {
+    return _size;
+  }
+
+  inline
+  bool equals(VM vm, RichNode right, WalkStack& stack);
+
+public:
+  // Operations
+
+  /** Returns the node holding the value mapped to key, or nullptr */
+  inline
+  StableNode* lookup(VM vm, RichNode key);
+
+  inline
+  bool member(VM vm, RichNode key);
+
+  inline
+  UnstableNode get(RichNode self, VM vm, RichNode key);
+
+  inline
+  UnstableNode condGet(VM vm, RichNode key, RichNode defaultValue);
+
+  inline
+  UnstableNode put(VM vm, RichNode key, RichNode value);
+
+  inline
+  UnstableNode remove(RichNode self, VM vm, RichNode key);
+
+  inline
+  UnstableNode keys(VM vm);
+
+  inline
+  UnstableNode items(VM vm);
+
+  inline
+  UnstableNode entries(VM vm);
+
+  inline
+  UnstableNode toRecord(VM vm, RichNode label);
+
+public:
+  // Serialization
+
+  inline
+  UnstableNode serialize(VM vm, SE se);
+
+public:
+  // Miscellaneous
+
+  void printReprToStream(VM vm, std::ostream& out, int depth, int width) {
+    out << "<PersistentMap " << _size << ">";
+  }
+
+private:
+  inline
+  static Hash hashFeature(VM vm, RichNode feature);
+
+  static Bitmap bitFor(Hash hash, size_t shift) {
+    return (Bitmap) 1 << ((hash >> shift) & (hashBits - 1));
+  }
+
+  inline
+  static UnstableNode buildNode(VM vm, size_t width,
+                                Bitmap dataMap, Bitmap nodeMap,
+                                StaticArray<StableNode>& elements);
+
+  inline
+  static void copyElements(VM vm, StaticArray<StableNode> dest,
+                           size_t destIndex, StaticArray<StableNode> source,
+                           size_t from, size_t to);
+
+  inline
+  static bool isInlinable(RichNode node);
+
+  inline
+  static UnstableNode insert(VM vm, RichNode node, Hash hash, size_t shift,
+                             RichNode key, RichNode value, bool& added);
+
+  inline
+  static UnstableNode mergeEntries(VM vm, size_t shift,
+                                   RichNode key1, RichNode value1, Hash hash1,
+                                   RichNode key2, RichNode value2, Hash hash2);
+
+  inline
+  static bool removeFrom(VM vm, RichNode node, Hash hash, size_t shift,
+                         RichNode key, UnstableNode& result);
+
+  template <class F>
+  inline
+  static void forEach(RichNode node, const F& f);
+
+  template <class F>
+  inline
+  UnstableNode foldToList(VM vm, const F& f);
+
+  size_t _size;
+  StableNode* _root;
+};
+
+#ifndef MOZART_GENERATOR
+#include "PersistentMap-implem-decl-after.hh"
+#endif
+
+}
+
+#endif // MOZART_PERSISTENTMAP_DECL_H
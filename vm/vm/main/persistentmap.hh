@@ -0,0 +1,538 @@
+// Copyright © 2014, Université catholique de Louvain
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// *  Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// *  Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MOZART_PERSISTENTMAP_H
+#define MOZART_PERSISTENTMAP_H
+
+#include "mozartcore.hh"
+
+#ifndef MOZART_GENERATOR
+
+namespace mozart {
+
+///////////////////////
+// PersistentMapNode //
+///////////////////////
+
+#include "PersistentMapNode-implem.hh"
+
+PersistentMapNode::PersistentMapNode(VM vm, size_t width,
+                                     Bitmap dataMap, Bitmap nodeMap):
+  _width(width), _dataMap(dataMap), _nodeMap(nodeMap) {
+
+  // The elements are filled in by the creator, see PersistentMap::buildNode
+}
+
+PersistentMapNode::PersistentMapNode(VM vm, size_t width, GR gr,
+                                     PersistentMapNode& from):
+  _width(width), _dataMap(from._dataMap), _nodeMap(from._nodeMap) {
+
+  gr->copyStableNodes(getElementsArray(), from.getElementsArray(), width);
+}
+
+///////////////////
+// PersistentMap //
+///////////////////
+
+#include "PersistentMap-implem.hh"
+
+namespace internal {
+  inline
+  std::uint32_t mixPersistentMapHash(std::uint64_t value) {
+    // Finalizer of MurmurHash3
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    value ^= value >> 33;
+    return (std::uint32_t) value;
+  }
+
+  inline
+  std::uint64_t hashPersistentMapBytes(const char* data, size_t length,
+                                       std::uint64_t seed) {
+    // FNV-1a
+    std::uint64_t result = 0xcbf29ce484222325ULL ^ seed;
+    for (size_t i = 0; i < length; i++) {
+      result ^= (unsigned char) data[i];
+      result *= 0x100000001b3ULL;
+    }
+    return result;
+  }
+}
+
+PersistentMap::PersistentMap(VM vm, size_t size, UnstableNode&& root):
+  _size(size) {
+
+  _root = new (vm) StableNode;
+  _root->init(vm, std::move(root));
+}
+
+PersistentMap::PersistentMap(VM vm, GR gr, PersistentMap& from):
+  _size(from._size), _root(nullptr) {
+
+  if (from._root != nullptr)
+    gr->copyStableRef(_root, from._root);
+}
+
+bool PersistentMap::equals(VM vm, RichNode right, WalkStack& stack) {
+  auto rhs = right.as<PersistentMap>();
+
+  if (_size != rhs.getSize())
+    return false;
+
+  if (_root == nullptr)
+    return true;
+
+  bool result = true;
+  forEach(*_root, [vm, &rhs, &stack, &result] (StableNode& key,
+                                                StableNode& value) {
+    if (!result)
+      return;
+
+    StableNode* rightValue = rhs.lookup(vm, key);
+    if (rightValue == nullptr)
+      result = false;
+    else
+      stack.push(vm, &value, rightValue);
+  });
+
+  return result;
+}
+
+StableNode* PersistentMap::lookup(VM vm, RichNode key) {
+  requireFeature(vm, key);
+
+  if (_root == nullptr)
+    return nullptr;
+
+  Hash hash = hashFeature(vm, key);
+  RichNode node = *_root;
+
+  for (size_t shift = 0; ; shift += bitsPerLevel) {
+    auto trie = node.as<PersistentMapNode>();
+    auto elements = trie.getElementsArray();
+
+    if (trie.isCollision()) {
+      for (size_t i = 0; i < trie.getArraySize(); i += 2) {
+        if (compareFeatures(vm, elements[i], key) == 0)
+          return &elements[i+1];
+      }
+      return nullptr;
+    }
+
+    Bitmap bit = bitFor(hash, shift);
+
+    if (trie.getDataMap() & bit) {
+      size_t index = 2 * trie.dataIndex(bit);
+      if (compareFeatures(vm, elements[index], key) == 0)
+        return &elements[index+1];
+      else
+        return nullptr;
+    } else if (trie.getNodeMap() & bit) {
+      node = elements[trie.nodeIndex(bit)];
+    } else {
+      return nullptr;
+    }
+  }
+}
+
+bool PersistentMap::member(VM vm, RichNode key) {
+  return lookup(vm, key) != nullptr;
+}
+
+UnstableNode PersistentMap::get(RichNode self, VM vm, RichNode key) {
+  StableNode* value = lookup(vm, key);
+  if (value == nullptr)
+    raiseKernelError(vm, ".", self, key);
+
+  return { vm, *value };
+}
+
+UnstableNode PersistentMap::condGet(VM vm, RichNode key,
+                                    RichNode defaultValue) {
+  StableNode* value = lookup(vm, key);
+  if (value == nullptr)
+    return { vm, defaultValue };
+  else
+    return { vm, *value };
+}
+
+UnstableNode PersistentMap::put(VM vm, RichNode key, RichNode value) {
+  requireFeature(vm, key);
+  Hash hash = hashFeature(vm, key);
+
+  if (_root == nullptr) {
+    StaticArray<StableNode> elements;
+    UnstableNode root = buildNode(vm, 2, bitFor(hash, 0), 0, elements);
+    elements[0].init(vm, key);
+    elements[1].init(vm, value);
+    return PersistentMap::build(vm, (size_t) 1, std::move(root));
+  }
+
+  bool added = false;
+  UnstableNode root = insert(vm, *_root, hash, 0, key, value, added);
+  return PersistentMap::build(vm, added ? _size+1 : _size, std::move(root));
+}
+
+UnstableNode PersistentMap::remove(RichNode self, VM vm, RichNode key) {
+  requireFeature(vm, key);
+
+  UnstableNode root;
+  if ((_root == nullptr) ||
+      !removeFrom(vm, *_root, hashFeature(vm, key), 0, key, root))
+    return { vm, self };
+
+  if (_size == 1)
+    return PersistentMap::build(vm);
+  else
+    return PersistentMap::build(vm, _size-1, std::move(root));
+}
+
+UnstableNode PersistentMap::keys(VM vm) {
+  return foldToList(vm, [vm] (StableNode& key, StableNode& value) {
+    return UnstableNode(vm, key);
+  });
+}
+
+UnstableNode PersistentMap::items(VM vm) {
+  return foldToList(vm, [vm] (StableNode& key, StableNode& value) {
+    return UnstableNode(vm, value);
+  });
+}
+
+UnstableNode PersistentMap::entries(VM vm) {
+  return foldToList(vm, [vm] (StableNode& key, StableNode& value) {
+    return buildTuple(vm, vm->coreatoms.sharp, key, value);
+  });
+}
+
+UnstableNode PersistentMap::toRecord(VM vm, RichNode label) {
+  auto elements = vm->newStaticArray<UnstableField>(_size);
+
+  if (_root != nullptr) {
+    size_t i = 0;
+    forEach(*_root, [vm, &elements, &i] (StableNode& key, StableNode& value) {
+      elements[i].feature.init(vm, key);
+      elements[i].value.init(vm, value);
+      i++;
+    });
+  }
+
+  UnstableNode result = buildRecordDynamic(vm, label, _size, elements);
+
+  vm->deleteStaticArray(elements, _size);
+  return result;
+}
+
+UnstableNode PersistentMap::serialize(VM vm, SE se) {
+  UnstableNode r = makeTuple(vm, vm->coreatoms.persistentMap, 2*_size);
+
+  if (_root != nullptr) {
+    auto elements = RichNode(r).as<Tuple>().getElementsArray();
+    size_t i = 0;
+    forEach(*_root, [se, &elements, &i] (StableNode& key, StableNode& value) {
+      se->copy(elements[i++], key);
+      se->copy(elements[i++], value);
+    });
+  }
+
+  return r;
+}
+
+auto PersistentMap::hashFeature(VM vm, RichNode feature) -> Hash {
+  using namespace internal;
+
+  // The hash must only depend on the contents of the feature, so that it
+  // survives garbage collections and pickling
+  if (feature.is<Atom>()) {
+    auto value = feature.as<Atom>().value();
+    return mixPersistentMapHash(
+      hashPersistentMapBytes(value.contents(), value.length(), 1));
+  } else if (feature.is<SmallInt>()) {
+    return mixPersistentMapHash((std::uint64_t) feature.as<SmallInt>().value());
+  } else if (feature.is<UniqueName>()) {
+    auto value = feature.as<UniqueName>().value();
+    return mixPersistentMapHash(
+      hashPersistentMapBytes(value.contents(), value.length(), 2));
+  } else if (feature.is<GlobalName>()) {
+    const UUID& uuid = feature.as<GlobalName>().getUUID();
+    return mixPersistentMapHash(uuid.data0 ^ (uuid.data1 * 31));
+  } else if (feature.is<NamedName>()) {
+    const UUID& uuid = feature.as<NamedName>().getUUID();
+    return mixPersistentMapHash(uuid.data0 ^ (uuid.data1 * 31));
+  } else if (feature.is<BigInt>()) {
+    std::string str = feature.as<BigInt>().str();
+    return mixPersistentMapHash(
+      hashPersistentMapBytes(str.data(), str.size(), 3));
+  } else if (feature.is<Boolean>()) {
+    return feature.as<Boolean>().value() ? 0x9e3779b9 : 0x7f4a7c15;
+  } else {
+    assert(feature.is<Unit>());
+    return 0x3c6ef372;
+  }
+}
+
+UnstableNode PersistentMap::buildNode(VM vm, size_t width,
+                                      Bitmap dataMap, Bitmap nodeMap,
+                                      StaticArray<StableNode>& elements) {
+  UnstableNode result = PersistentMapNode::build(vm, width, dataMap, nodeMap);
+  elements = RichNode(result).as<PersistentMapNode>().getElementsArray();
+  return result;
+}
+
+void PersistentMap::copyElements(VM vm, StaticArray<StableNode> dest,
+                                 size_t destIndex,
+                                 StaticArray<StableNode> source,
+                                 size_t from, size_t to) {
+  // Non-copyable elements, such as sub-nodes, become shared references
+  for (size_t i = from; i < to; i++)
+    dest[destIndex++].init(vm, source[i]);
+}
+
+bool PersistentMap::isInlinable(RichNode node) {
+  auto trie = node.as<PersistentMapNode>();
+  return (trie.getNodeMap() == 0) && (trie.getArraySize() == 2);
+}
+
+UnstableNode PersistentMap::insert(VM vm, RichNode node, Hash hash,
+                                   size_t shift, RichNode key, RichNode value,
+                                   bool& added) {
+  auto trie = node.as<PersistentMapNode>();
+  auto elements = trie.getElementsArray();
+  size_t width = trie.getArraySize();
+  StaticArray<StableNode> resultElements;
+
+  if (trie.isCollision()) {
+    for (size_t i = 0; i < width; i += 2) {
+      if (compareFeatures(vm, elements[i], key) == 0) {
+        added = false;
+        auto result = buildNode(vm, width, 0, 0, resultElements);
+        copyElements(vm, resultElements, 0, elements, 0, i+1);
+        resultElements[i+1].init(vm, value);
+        copyElements(vm, resultElements, i+2, elements, i+2, width);
+        return result;
+      }
+    }
+
+    added = true;
+    auto result = buildNode(vm, width+2, 0, 0, resultElements);
+    copyElements(vm, resultElements, 0, elements, 0, width);
+    resultElements[width].init(vm, key);
+    resultElements[width+1].init(vm, value);
+    return result;
+  }
+
+  Bitmap dataMap = trie.getDataMap();
+  Bitmap nodeMap = trie.getNodeMap();
+  Bitmap bit = bitFor(hash, shift);
+
+  if (dataMap & bit) {
+    size_t index = 2 * trie.dataIndex(bit);
+    RichNode existingKey = elements[index];
+
+    if (compareFeatures(vm, existingKey, key) == 0) {
+      // Replace the value
+      added = false;
+      auto result = buildNode(vm, width, dataMap, nodeMap, resultElements);
+      copyElements(vm, resultElements, 0, elements, 0, index+1);
+      resultElements[index+1].init(vm, value);
+      copyElements(vm, resultElements, index+2, elements, index+2, width);
+      return result;
+    }
+
+    // Push both entries down into a new sub-node
+    added = true;
+    auto child = mergeEntries(vm, shift + bitsPerLevel,
+                              existingKey, elements[index+1],
+                              hashFeature(vm, existingKey),
+                              key, value, hash);
+    size_t childIndex = trie.nodeIndex(bit) - 2;
+
+    auto result = buildNode(vm, width-1, dataMap & ~bit, nodeMap | bit,
+                            resultElements);
+    copyElements(vm, resultElements, 0, elements, 0, index);
+    copyElements(vm, resultElements, index, elements, index+2, childIndex+2);
+    resultElements[childIndex].init(vm, std::move(child));
+    copyElements(vm, resultElements, childIndex+1,
+                 elements, childIndex+2, width);
+    return result;
+  } else if (nodeMap & bit) {
+    size_t index = trie.nodeIndex(bit);
+    auto child = insert(vm, elements[index], hash, shift + bitsPerLevel,
+                        key, value, added);
+
+    auto result = buildNode(vm, width, dataMap, nodeMap, resultElements);
+    copyElements(vm, resultElements, 0, elements, 0, index);
+    resultElements[index].init(vm, std::move(child));
+    copyElements(vm, resultElements, index+1, elements, index+1, width);
+    return result;
+  } else {
+    // Add a new entry in this node
+    added = true;
+    size_t index = 2 * trie.dataIndex(bit);
+
+    auto result = buildNode(vm, width+2, dataMap | bit, nodeMap,
+                            resultElements);
+    copyElements(vm, resultElements, 0, elements, 0, index);
+    resultElements[index].init(vm, key);
+    resultElements[index+1].init(vm, value);
+    copyElements(vm, resultElements, index+2, elements, index, width);
+    return result;
+  }
+}
+
+UnstableNode PersistentMap::mergeEntries(VM vm, size_t shift,
+                                         RichNode key1, RichNode value1,
+                                         Hash hash1,
+                                         RichNode key2, RichNode value2,
+                                         Hash hash2) {
+  StaticArray<StableNode> elements;
+
+  if (shift >= hashBits) {
+    // All the bits of the hashes are equal
+    auto result = buildNode(vm, 4, 0, 0, elements);
+    elements[0].init(vm, key1);
+    elements[1].init(vm, value1);
+    elements[2].init(vm, key2);
+    elements[3].init(vm, value2);
+    return result;
+  }
+
+  Bitmap bit1 = bitFor(hash1, shift);
+  Bitmap bit2 = bitFor(hash2, shift);
+
+  if (bit1 == bit2) {
+    auto child = mergeEntries(vm, shift + bitsPerLevel,
+                              key1, value1, hash1, key2, value2, hash2);
+    auto result = buildNode(vm, 1, 0, bit1, elements);
+    elements[0].init(vm, std::move(child));
+    return result;
+  }
+
+  auto result = buildNode(vm, 4, bit1 | bit2, 0, elements);
+  size_t index1 = (bit1 < bit2) ? 0 : 2;
+  size_t index2 = 2 - index1;
+  elements[index1].init(vm, key1);
+  elements[index1+1].init(vm, value1);
+  elements[index2].init(vm, key2);
+  elements[index2+1].init(vm, value2);
+  return result;
+}
+
+bool PersistentMap::removeFrom(VM vm, RichNode node, Hash hash, size_t shift,
+                               RichNode key, UnstableNode& result) {
+  auto trie = node.as<PersistentMapNode>();
+  auto elements = trie.getElementsArray();
+  size_t width = trie.getArraySize();
+  StaticArray<StableNode> resultElements;
+
+  if (trie.isCollision()) {
+    for (size_t i = 0; i < width; i += 2) {
+      if (compareFeatures(vm, elements[i], key) == 0) {
+        result = buildNode(vm, width-2, 0, 0, resultElements);
+        copyElements(vm, resultElements, 0, elements, 0, i);
+        copyElements(vm, resultElements, i, elements, i+2, width);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  Bitmap dataMap = trie.getDataMap();
+  Bitmap nodeMap = trie.getNodeMap();
+  Bitmap bit = bitFor(hash, shift);
+
+  if (dataMap & bit) {
+    size_t index = 2 * trie.dataIndex(bit);
+    if (compareFeatures(vm, elements[index], key) != 0)
+      return false;
+
+    result = buildNode(vm, width-2, dataMap & ~bit, nodeMap, resultElements);
+    copyElements(vm, resultElements, 0, elements, 0, index);
+    copyElements(vm, resultElements, index, elements, index+2, width);
+    return true;
+  } else if (nodeMap & bit) {
+    size_t index = trie.nodeIndex(bit);
+    UnstableNode child;
+    if (!removeFrom(vm, elements[index], hash, shift + bitsPerLevel,
+                    key, child))
+      return false;
+
+    if (isInlinable(child)) {
+      // Only one entry is left in the sub-node: pull it up into this node,
+      // so that the shape of the trie depends only on its contents
+      auto childElements = RichNode(child).as<PersistentMapNode>()
+        .getElementsArray();
+      size_t dataIndex = 2 * trie.dataIndex(bit);
+
+      result = buildNode(vm, width+1, dataMap | bit, nodeMap & ~bit,
+                         resultElements);
+      copyElements(vm, resultElements, 0, elements, 0, dataIndex);
+      copyElements(vm, resultElements, dataIndex, childElements, 0, 2);
+      copyElements(vm, resultElements, dataIndex+2, elements, dataIndex, index);
+      copyElements(vm, resultElements, index+2, elements, index+1, width);
+    } else {
+      result = buildNode(vm, width, dataMap, nodeMap, resultElements);
+      copyElements(vm, resultElements, 0, elements, 0, index);
+      resultElements[index].init(vm, std::move(child));
+      copyElements(vm, resultElements, index+1, elements, index+1, width);
+    }
+    return true;
+  } else {
+    return false;
+  }
+}
+
+template <class F>
+void PersistentMap::forEach(RichNode node, const F& f) {
+  auto trie = node.as<PersistentMapNode>();
+  auto elements = trie.getElementsArray();
+  size_t entriesEnd = 2 * trie.getEntryCount();
+
+  for (size_t i = 0; i < entriesEnd; i += 2)
+    f(elements[i], elements[i+1]);
+
+  for (size_t i = entriesEnd; i < trie.getArraySize(); i++)
+    forEach(elements[i], f);
+}
+
+template <class F>
+UnstableNode PersistentMap::foldToList(VM vm, const F& f) {
+  OzListBuilder builder(vm);
+
+  if (_root != nullptr) {
+    forEach(*_root, [vm, &builder, &f] (StableNode& key, StableNode& value) {
+      builder.push_back(vm, f(key, value));
+    });
+  }
+
+  return builder.get(vm);
+}
+
+}
+
+#endif // MOZART_GENERATOR
+
+#endif // MOZART_PERSISTENTMAP_H
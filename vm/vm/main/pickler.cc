@@ -24,6 +24,10 @@
 
 #include "mozart.hh"
 
+#ifdef USE_ZLIB
+#include <zlib.h>
+#endif
+
 namespace mozart {
 
 /////////////
@@ -40,6 +44,7 @@ UnstableNode Pickler::buildTypesRecord(VM vm) {
       atoms.atom,
       atoms.bool_,
       atoms.builtin,
+      atoms.byteString,
       atoms.chunk,
       atoms.codearea,
       atoms.cons,
@@ -51,6 +56,7 @@ UnstableNode Pickler::buildTypesRecord(VM vm) {
       atoms.patmatconjunction,
       atoms.patmatopenrecord,
       atoms.patmatwildcard,
+      atoms.persistentMap,
       atoms.record,
       atoms.tuple,
       atoms.unicodeString,
@@ -58,10 +64,10 @@ UnstableNode Pickler::buildTypesRecord(VM vm) {
       atoms.unit
     ),
     16, 8, 5, 3, 10,
-    17, 11, 6, 2, 1,
-    19, 20, 13, 14, 15,
-    12, 9, 7, 21, 18,
-    4);
+    23, 17, 11, 6, 2,
+    1, 19, 20, 13, 14,
+    15, 12, 22, 9, 7,
+    21, 18, 4);
 }
 
 static void restoreNodes(VM vm, VMAllocatedList<NodeBackup>& list) {
@@ -72,15 +78,6 @@ static void restoreNodes(VM vm, VMAllocatedList<NodeBackup>& list) {
 }
 
 void Pickler::pickle(RichNode value, RichNode temporaryReplacement) {
-  auto typesRecord = RichNode(*vm->getPickleTypesRecord()).as<Record>();
-  auto statelessTypes = RichNode(*typesRecord.getArity()).as<Arity>();
-
-  bool futures = false;
-  nativeint count = 0;
-  VMAllocatedList<NodeBackup> nodeBackups;
-  VMAllocatedList<PickleNode> nodes;
-  UnstableNode resources = buildNil(vm);
-
   // Apply temporary replacements.
   VMAllocatedList<NodeBackup> nodeReplacementBackups;
   {
@@ -105,45 +102,64 @@ void Pickler::pickle(RichNode value, RichNode temporaryReplacement) {
     replacements.clear(vm);
   }
 
-  SerializationCallback cb(vm);
-  UnstableNode topLevelIndex = OptVar::build(vm);
-  cb.copy(topLevelIndex, value);
+  // The tables of the Pickler live outside the VM heap, and a raise skips
+  // their destructors, hence they are freed before the exception leaves.
+  MOZART_TRY(vm) {
+    pickleReplaced(value);
+  } MOZART_CATCH(vm, kind, node) {
+    releaseTables();
+    restoreNodes(vm, nodeReplacementBackups);
+    MOZART_RETHROW(vm);
+  } MOZART_ENDTRY(vm);
+
+  restoreNodes(vm, nodeReplacementBackups);
+}
 
-  // Replace serialized nodes by Serialized(index)
-  // and add them to the nodes list
-  while (!cb.todoFrom.empty()) {
-    RichNode from = cb.todoFrom.pop_front(vm);
-    RichNode to = cb.todoTo.pop_front(vm);
+void Pickler::pickleReplaced(RichNode value) {
+  auto typesRecord = RichNode(*vm->getPickleTypesRecord()).as<Record>();
+  auto statelessTypes = RichNode(*typesRecord.getArity()).as<Arity>();
 
-    if (from.is<Serialized>()) {
-      UnstableNode n = mozart::build(vm, from.as<Serialized>().n());
-      DataflowVariable(to).bind(vm, n);
-    } else {
-      ++count;
-      StableNode* refs = new (vm) StableNode(vm, from.type()->serialize(vm, &cb, from));
-      nodes.push_front(vm, { count, from, refs });
-
-      if (!futures) {
-        UnstableNode type = RecordLike(*refs).label(vm);
-        size_t _offset;
-        if (isFuture(from)) {
-          futures = true;
-        } else if (!statelessTypes.lookupFeature(vm, type, _offset)) {
-          resources = buildCons(vm, from, std::move(resources));
-        }
+  bool futures = false;
+  UnstableNode resources = buildNil(vm);
+
+  // Give an index to every reachable node. Nodes of the built-in types are
+  // recorded directly from their fields, without allocating anything in the
+  // heap. Other nodes go through serialize(), which builds a record of their
+  // contents.
+  SerializationCallback cb(vm);
+  nativeint topLevelIndex = indexOf(value);
+
+  for (size_t i = 0; i < nodes.size(); i++) {
+    if (serializeDirect(i))
+      continue;
+
+    RichNode from = nodes[i].node;
+    StableNode* refs = new (vm) StableNode(vm, from.type()->serialize(vm, &cb, from));
+    UnstableNode type = RecordLike(*refs).label(vm);
+
+    if (!futures) {
+      size_t _offset;
+      if (isFuture(from)) {
+        futures = true;
+      } else if (!statelessTypes.lookupFeature(vm, type, _offset)) {
+        resources = buildCons(vm, from, std::move(resources));
       }
+    }
 
-      nodeBackups.push_front(vm, from.makeBackup());
-      from.reinit(vm, Serialized::build(vm, count));
+    UnstableNode id;
+    if (typesRecord.lookupFeature(vm, type, id))
+      nodes[i].type = (unsigned char) RichNode(id).as<SmallInt>().value();
+    nodes[i].refs = refs;
 
-      UnstableNode n = mozart::build(vm, count);
+    // Replace the children in the record by their index
+    while (!cb.todoFrom.empty()) {
+      RichNode child = cb.todoFrom.pop_front(vm);
+      RichNode to = cb.todoTo.pop_front(vm);
+      UnstableNode n = mozart::build(vm, indexOf(child));
       DataflowVariable(to).bind(vm, n);
     }
   }
 
-  // Restore nodes
-  restoreNodes(vm, nodeBackups);
-
   // Ensure no remaining futures or resources.
   if (futures) {
     for (auto& pickleNode : nodes) {
@@ -154,16 +170,10 @@ void Pickler::pickle(RichNode value, RichNode temporaryReplacement) {
 
     for (auto& pickleNode : nodes) {
       if (isFuture(pickleNode.node)) {
-        RichNode future = pickleNode.node;
-        nodes.clear(vm);
-        restoreNodes(vm, nodeReplacementBackups);
-        waitFor(vm, future);
+        waitFor(vm, pickleNode.node);
       }
     }
   } else if (!RichNode(resources).is<Atom>()) {
-    nodes.clear(vm);
-    restoreNodes(vm, nodeReplacementBackups);
-
     raiseError(vm, "dp",
       "generic",
       "pickle:resources",
@@ -174,6 +184,7 @@ void Pickler::pickle(RichNode value, RichNode temporaryReplacement) {
   }
 
   // header
+  nativeint count = nodes.size();
   writeSize(count);
   writeSize(topLevelIndex);
 
@@ -184,77 +195,163 @@ void Pickler::pickle(RichNode value, RichNode temporaryReplacement) {
     redirections[(int) i] = i;
   }
 
-  writeValues(nodes);
-  writeArities(nodes);
-  writeOthers(nodes);
+  writeValues();
+  writeArities();
+  writeOthers();
 
   vm->deleteStaticArray(redirections, count+1);
 
   nativeint eof = 0;
   writeSize(eof);
+}
 
-  nodes.clear(vm);
-  restoreNodes(vm, nodeReplacementBackups);
+void Pickler::releaseTables() {
+  decltype(nodes)().swap(nodes);
+  decltype(childRefs)().swap(childRefs);
+  decltype(indices)().swap(indices);
+
+  decltype(writtenAtoms)().swap(writtenAtoms);
+  decltype(writtenInts)().swap(writtenInts);
+  writtenOtherFeatures.removeAll(vm);
+  decltype(writtenBuiltins)().swap(writtenBuiltins);
+  decltype(writtenArities)().swap(writtenArities);
+}
+
+nativeint Pickler::indexOf(RichNode node) {
+  auto inserted = indices.emplace(node.node(), (nativeint) nodes.size() + 1);
+  if (inserted.second)
+    nodes.push_back({ inserted.first->second, node, 0, false, nullptr, 0, 0 });
+  return inserted.first->second;
+}
+
+void Pickler::addRef(RichNode child) {
+  childRefs.push_back(indexOf(child));
 }
 
-void Pickler::writeValues(VMAllocatedList<PickleNode>& nodes) {
-  NodeDictionary existingFeatures;
-  NodeDictionary existingBuiltins;
-  auto iter = nodes.removable_begin();
-  auto end = nodes.removable_end();
+void Pickler::addRefs(StaticArray<StableNode> children, size_t count) {
+  for (size_t i = 0; i < count; i++)
+    addRef(children[i]);
+}
+
+bool Pickler::serializeDirect(size_t position) {
+  RichNode node = nodes[position].node;
+  size_t firstRef = childRefs.size();
+  unsigned char type;
+
+  if (node.is<SmallInt>()) {
+    type = 1;
+  } else if (node.is<Float>()) {
+    type = 2;
+  } else if (node.is<Boolean>()) {
+    type = 3;
+  } else if (node.is<Unit>()) {
+    type = 4;
+  } else if (node.is<Atom>()) {
+    type = 5;
+  } else if (node.is<Cons>()) {
+    type = 6;
+    auto cons = node.as<Cons>();
+    addRef(*cons.getHead());
+    addRef(*cons.getTail());
+  } else if (node.is<Tuple>()) {
+    type = 7;
+    auto tuple = node.as<Tuple>();
+    addRef(*tuple.getLabel());
+    addRefs(tuple.getElementsArray(), tuple.getWidth());
+  } else if (node.is<Arity>()) {
+    type = 8;
+    auto arity = node.as<Arity>();
+    addRef(*arity.getLabel());
+    addRefs(arity.getElementsArray(), arity.getWidth());
+  } else if (node.is<Record>()) {
+    type = 9;
+    auto record = node.as<Record>();
+    addRef(*record.getArity());
+    addRefs(record.getElementsArray(), record.getWidth());
+  } else if (node.is<CodeArea>()) {
+    type = 11;
+    auto codeArea = node.as<CodeArea>();
+    addRef(*codeArea.getDebugData());
+    addRefs(codeArea.getElementsArray(), codeArea.getArraySize());
+  } else if (node.is<Abstraction>()) {
+    type = 16;
+    auto abstraction = node.as<Abstraction>();
+    addRef(*abstraction.getBody());
+    addRefs(abstraction.getElementsArray(), abstraction.getArraySize());
+  } else if (node.is<UniqueName>()) {
+    type = 18;
+  } else if (node.is<GlobalName>()) {
+    type = 19;
+  } else if (node.is<NamedName>()) {
+    type = 20;
+  } else if (node.is<String>()) {
+    type = 21;
+  } else if (node.is<ByteString>()) {
+    type = 23;
+  } else {
+    return false;
+  }
 
-  while (iter != end) {
+  auto& pickleNode = nodes[position];
+  pickleNode.type = type;
+  pickleNode.firstRef = firstRef;
+  pickleNode.refCount = childRefs.size() - firstRef;
+  return true;
+}
+
+void Pickler::writeValues() {
+  for (auto iter = nodes.rbegin(); iter != nodes.rend(); ++iter) {
     RichNode node = iter->node;
     if (node.isFeature()) {
-      if (!findFeature(existingFeatures, iter->index, node))
-        writeNode(iter->index, node, *iter->refs);
-      iter = nodes.remove(vm, iter);
+      if (!findFeature(iter->index, node))
+        writeNode(*iter);
+      iter->written = true;
     } else if (node.is<BuiltinProcedure>()) {
-      if (!findBuiltin(existingBuiltins, iter->index, *iter->refs))
-        writeNode(iter->index, node, *iter->refs);
-      iter = nodes.remove(vm, iter);
+      if (!findBuiltin(iter->index, node))
+        writeNode(*iter);
+      iter->written = true;
     } else if (node.type().getStructuralBehavior() == sbValue) {
-      writeNode(iter->index, node, *iter->refs);
-      iter = nodes.remove(vm, iter);
-    } else {
-      ++iter;
+      writeNode(*iter);
+      iter->written = true;
     }
   }
 
-  existingFeatures.removeAll(vm);
+  writtenOtherFeatures.removeAll(vm);
 }
 
-void Pickler::writeArities(VMAllocatedList<PickleNode>& nodes) {
-  NodeDictionary existingsArities;
-  auto iter = nodes.removable_begin();
-  auto end = nodes.removable_end();
-
-  while (iter != end) {
-    RichNode node = iter->node;
-    if (node.is<Arity>()) {
-      if (!findArity(existingsArities, iter->index, node, *iter->refs))
-        writeNode(iter->index, node, *iter->refs);
-      iter = nodes.remove(vm, iter);
-    } else {
-      ++iter;
+void Pickler::writeArities() {
+  for (auto iter = nodes.rbegin(); iter != nodes.rend(); ++iter) {
+    if (!iter->written && iter->node.is<Arity>()) {
+      if (!findArity(*iter))
+        writeNode(*iter);
+      iter->written = true;
     }
   }
-
-  existingsArities.removeAll(vm);
 }
 
-void Pickler::writeOthers(VMAllocatedList<PickleNode>& nodes) {
-  while (!nodes.empty()) {
-    auto& pickleNode = nodes.front();
-    writeNode(pickleNode.index, pickleNode.node, *pickleNode.refs);
-    nodes.remove_front(vm);
+void Pickler::writeOthers() {
+  for (auto iter = nodes.rbegin(); iter != nodes.rend(); ++iter) {
+    if (!iter->written) {
+      writeNode(*iter);
+      iter->written = true;
+    }
   }
 }
 
-bool Pickler::findFeature(NodeDictionary& existingFeatures,
-                          nativeint index, RichNode node) {
+bool Pickler::findFeature(nativeint index, RichNode node) {
+  // Atoms are interned and small integers compare by value, so that they
+  // are looked up by identity. Other features are rare.
+  if (node.is<Atom>()) {
+    auto inserted = writtenAtoms.emplace(
+      node.as<Atom>().value().contents(), index);
+    return findWritten(inserted.first->second, index);
+  } else if (node.is<SmallInt>()) {
+    auto inserted = writtenInts.emplace(node.as<SmallInt>().value(), index);
+    return findWritten(inserted.first->second, index);
+  }
+
   UnstableNode* redir = nullptr;
-  if (existingFeatures.lookupOrCreate(vm, node, redir)) {
+  if (writtenOtherFeatures.lookupOrCreate(vm, node, redir)) {
     redirections[(size_t) index] = RichNode(*redir).as<SmallInt>().value();
     return true;
   } else {
@@ -263,66 +360,141 @@ bool Pickler::findFeature(NodeDictionary& existingFeatures,
   }
 }
 
-bool Pickler::findBuiltin(NodeDictionary& existingBuiltins,
-                          nativeint index, RichNode refsTuple) {
-  auto refs = refsTuple.as<Tuple>();
-  RichNode moduleName = *refs.getElement(0);
-  RichNode builtinName = *refs.getElement(1);
-
-  UnstableNode* moduleDict = nullptr;
-  if (existingBuiltins.lookupOrCreate(vm, moduleName, moduleDict)) {
-    NodeDictionary& module = RichNode(*moduleDict).as<Dictionary>().getDict();
-    UnstableNode* redir;
-    if (module.lookupOrCreate(vm, builtinName, redir)) {
-      redirections[(size_t) index] = RichNode(*redir).as<SmallInt>().value();
-      return true;
-    } else {
-      redir->copy(vm, build(vm, index));
-      return false;
-    }
-  } else {
-    moduleDict->copy(vm, Dictionary::build(vm));
-    UnstableNode idx = build(vm, index);
-    RichNode(*moduleDict).as<Dictionary>().dictPut(vm, builtinName, idx);
+bool Pickler::findBuiltin(nativeint index, RichNode node) {
+  auto inserted = writtenBuiltins.emplace(
+    node.as<BuiltinProcedure>().value(), index);
+  return findWritten(inserted.first->second, index);
+}
+
+bool Pickler::findArity(PickleNode& pickleNode) {
+  // Label and features have already been written, hence their redirected
+  // indices identify them
+  std::vector<nativeint> key;
+  key.reserve(pickleNode.refCount);
+  for (size_t i = 0; i < pickleNode.refCount; i++)
+    key.push_back(redirections[(size_t) childRefs[pickleNode.firstRef + i]]);
+
+  auto inserted = writtenArities.emplace(std::move(key), pickleNode.index);
+  return findWritten(inserted.first->second, pickleNode.index);
+}
+
+bool Pickler::findWritten(nativeint written, nativeint index) {
+  if (written == index)
     return false;
-  }
+  redirections[(size_t) index] = written;
+  return true;
 }
 
-bool Pickler::findArity(NodeDictionary& existingsArities,
-                        nativeint index, RichNode node, RichNode refsTuple) {
-  using namespace patternmatching;
+void Pickler::writeNode(PickleNode& pickleNode) {
+  writeSize(pickleNode.index);
+  writeByte(pickleNode.type);
 
-  auto refs = refsTuple.as<Tuple>();
-  RichNode ref = *refs.getElement(refs.getWidth()-1);
-  UnstableNode labelRef = build(vm, redirections[(size_t) ref.as<SmallInt>().value()]);
+  if (pickleNode.refs == nullptr)
+    writeDirectNode(pickleNode);
+  else
+    writeSerializedNode(pickleNode.type, pickleNode.node, *pickleNode.refs);
+}
 
-  UnstableNode* redir = nullptr;
-  if (existingsArities.lookupOrCreate(vm, labelRef, redir)) {
-    RichNode head, tail, list = *redir;
-    while (matchesCons(vm, list, capture(head), capture(tail))) {
-      RichNode writtenIndex;
-      if (matchesSharp(vm, head, capture(writtenIndex), node)) {
-        redirections[(size_t) index] = writtenIndex.as<SmallInt>().value();
-        return true;
+void Pickler::writeDirectNode(PickleNode& pickleNode) {
+  RichNode node = pickleNode.node;
+  nativeint* refs = childRefs.data() + pickleNode.firstRef;
+
+  switch (pickleNode.type) {
+    case 1: { // int
+      internal::IntToStrBuffer buffer;
+      auto length = internal::intToStrBuffer(buffer, node.as<SmallInt>().value());
+      writeStr(buffer, length);
+      break;
+    }
+
+    case 2: { // float
+      internal::FloatToStrBuffer buffer;
+      auto length = internal::floatToStrBuffer(buffer, node.as<Float>().value());
+      writeStr(buffer, length);
+      break;
+    }
+
+    case 3: // bool
+      writeByte(node.as<Boolean>().value());
+      break;
+
+    case 4: // unit
+      break;
+
+    case 5: // atom
+      writeAtom(node);
+      break;
+
+    case 6: // cons
+      writeRef(refs[0]);
+      writeRef(refs[1]);
+      break;
+
+    case 7: // tuple
+    case 8: // arity
+    case 9: // record
+      writeDirectRefsLastFirst(pickleNode);
+      break;
+
+    case 11: { // codearea
+      auto codeArea = node.as<CodeArea>();
+      writeUUIDOf(node);
+      ByteCode* code = codeArea.getCodeBlock(vm);
+      size_t codeSize = codeArea.getCodeBlockSize() / sizeof(ByteCode);
+      writeSize(codeSize);
+      for (size_t i = 0; i < codeSize; i++) {
+        writeByte(code[i] >> 8 & 0xff);
+        writeByte(code[i] & 0xff);
       }
-      list = tail;
+      writeSize(codeArea.getArity());
+      writeSize(codeArea.getXcount());
+      writeAtom(codeArea.getPrintName());
+      writeRef(refs[0]); // debugData
+      writeSize(pickleNode.refCount - 1);
+      for (size_t i = 1; i < pickleNode.refCount; i++)
+        writeRef(refs[i]); // Ks
+      break;
+    }
+
+    case 16: // abstraction
+      writeUUIDOf(node);
+      writeDirectRefsLastFirst(pickleNode);
+      break;
+
+    case 18: { // uniquename
+      auto name = node.as<UniqueName>().value();
+      writeStr(name.contents(), name.length());
+      break;
     }
-    redir->copy(vm, buildCons(vm, buildSharp(vm, index, node), std::move(*redir)));
-    return false;
-  } else {
-    redir->copy(vm, buildList(vm, buildSharp(vm, index, node)));
-    return false;
-  }
-}
 
-void Pickler::writeNode(nativeint index, RichNode node, RichNode refsTuple) {
-  UnstableNode type = RecordLike(refsTuple).label(vm), value;
-  RichNode(*vm->getPickleTypesRecord()).as<Record>().lookupFeature(vm, type, value);
-  nativeint id = RichNode(value).as<SmallInt>().value();
+    case 19: // name
+      writeUUIDOf(node);
+      break;
+
+    case 20: // namedname
+      writeUUIDOf(node);
+      writeAtom(node.as<NamedName>().getPrintName(vm));
+      break;
+
+    case 21: { // unicodeString
+      auto str = node.as<String>().value();
+      writeStr(str.string, str.length);
+      break;
+    }
+
+    case 23: { // byteString
+      auto& bytes = node.as<ByteString>().value();
+      writeStr(reinterpret_cast<const char*>(bytes.string), bytes.length);
+      break;
+    }
 
-  writeSize(index);
-  writeByte(id);
+    default:
+      assert(false && "no direct encoding for this type");
+  }
+}
 
+void Pickler::writeSerializedNode(nativeint id, RichNode node,
+                                  RichNode refsTuple) {
   switch (id) {
     case 1: // int
     case 2: // float
@@ -423,8 +595,18 @@ void Pickler::writeNode(nativeint index, RichNode node, RichNode refsTuple) {
       break;
     }
 
+    case 22: // persistentMap
+      writeRefs(refsTuple);
+      break;
+
+    case 23: { // byteString
+      auto& bytes = node.as<ByteString>().value();
+      writeStr(reinterpret_cast<const char*>(bytes.string), bytes.length);
+      break;
+    }
+
     default:
-      raiseError(vm, "Unknown type to pickle", type);
+      raiseError(vm, "Unknown type to pickle", RecordLike(refsTuple).label(vm));
   }
 }
 
@@ -448,9 +630,12 @@ void Pickler::writeStr(const char* str, size_t len) {
   output.write(str, len);
 }
 
+void Pickler::writeAtom(atom_t atom) {
+  writeStr(atom.contents(), atom.length());
+}
+
 void Pickler::writeAtom(RichNode atom) {
-  auto str = atom.as<Atom>().value();
-  writeStr(str.contents(), str.length());
+  writeAtom(atom.as<Atom>().value());
 }
 
 void Pickler::writeAsVS(RichNode node) {
@@ -460,8 +645,12 @@ void Pickler::writeAsVS(RichNode node) {
   writeStr(buffer.data(), buffer.size());
 }
 
+void Pickler::writeRef(nativeint ref) {
+  writeSize(redirections[(size_t) ref]);
+}
+
 void Pickler::writeRef(RichNode ref) {
-  writeSize(redirections[(size_t) ref.as<SmallInt>().value()]);
+  writeRef(ref.as<SmallInt>().value());
 }
 
 void Pickler::writeNRefs(RichNode refs, size_t n) {
@@ -482,6 +671,14 @@ void Pickler::writeRefsLastFirst(RichNode refsTuple) {
   writeNRefs(refsTuple, width-1);
 }
 
+void Pickler::writeDirectRefsLastFirst(PickleNode& pickleNode) {
+  nativeint* refs = childRefs.data() + pickleNode.firstRef;
+  writeRef(refs[0]);
+  writeSize(pickleNode.refCount - 1);
+  for (size_t i = 1; i < pickleNode.refCount; i++)
+    writeRef(refs[i]);
+}
+
 void Pickler::writeUUIDOf(RichNode node) {
   UUID uuid = node.type()->globalize(vm, node)->uuid;
   char buffer[UUID::byte_count];
@@ -489,4 +686,135 @@ void Pickler::writeUUIDOf(RichNode node) {
   output.write(buffer, UUID::byte_count);
 }
 
+///////////////////////
+// Compressed format //
+///////////////////////
+
+#ifdef USE_ZLIB
+
+namespace {
+
+/**
+ * Stream buffer that deflates what is written into another stream
+ * Both its input and output buffers have a fixed size, so that the whole
+ * pickle never is in memory at once. The header and the zlib state are only
+ * created when the first bytes are flushed, hence nothing is written for a
+ * value that the Pickler rejects before writing anything.
+ */
+class DeflateBuffer: public std::streambuf {
+public:
+  DeflateBuffer(std::ostream& output, int level):
+    output(output), level(level), started(false) {
+    setp(input, input + sizeof(input));
+  }
+
+  /** Deflate the remaining input and end the stream, false on failure */
+  bool finish() {
+    bool success = deflateInput(Z_FINISH);
+    release();
+    return success;
+  }
+
+  /** Free the zlib state */
+  void release() {
+    if (started)
+      deflateEnd(&stream);
+    started = false;
+  }
+
+protected:
+  int_type overflow(int_type ch) {
+    if (!deflateInput(Z_NO_FLUSH))
+      return traits_type::eof();
+    if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+      *pptr() = traits_type::to_char_type(ch);
+      pbump(1);
+    }
+    return traits_type::not_eof(ch);
+  }
+
+private:
+  bool deflateInput(int flush) {
+    if (!started) {
+      stream.zalloc = Z_NULL;
+      stream.zfree = Z_NULL;
+      stream.opaque = Z_NULL;
+      if (deflateInit(&stream, level) != Z_OK)
+        return false;
+      started = true;
+      output.put((char) 0xFF).put('O').put('Z').put(zlibPickleMethod);
+    }
+
+    stream.next_in = reinterpret_cast<Bytef*>(pbase());
+    stream.avail_in = (uInt) (pptr() - pbase());
+    int status;
+    do {
+      stream.next_out = reinterpret_cast<Bytef*>(deflated);
+      stream.avail_out = sizeof(deflated);
+      status = deflate(&stream, flush);
+      if (status == Z_STREAM_ERROR)
+        return false;
+      output.write(deflated, sizeof(deflated) - stream.avail_out);
+    } while (stream.avail_out == 0);
+
+    setp(input, input + sizeof(input));
+    return (flush != Z_FINISH) || (status == Z_STREAM_END);
+  }
+
+private:
+  std::ostream& output;
+  int level;
+  bool started;
+  z_stream stream;
+  char input[8192];
+  char deflated[8192];
+};
+
+} // namespace <anonymous>
+
+#endif // USE_ZLIB
+
+bool isPickleCompressionSupported(PickleCompression compression) {
+  switch (compression) {
+    case PickleCompression::none:
+      return true;
+    case PickleCompression::zlib:
+#ifdef USE_ZLIB
+      return true;
+#else
+      return false;
+#endif
+  }
+  return false;
+}
+
+void pickle(VM vm, RichNode value, RichNode temporaryReplacement,
+            const PickleOptions& options, std::ostream& output) {
+  if (!isPickleCompressionSupported(options.compression)) {
+    raiseError(vm, "dp", "generic", "pickle:compression",
+               "This compression method is not supported by this build",
+               buildNil(vm));
+  }
+
+  if (options.compression == PickleCompression::none) {
+    pickle(vm, value, temporaryReplacement, output);
+    return;
+  }
+
+#ifdef USE_ZLIB
+  DeflateBuffer buffer(output, options.level);
+  std::ostream stream(&buffer);
+  MOZART_TRY(vm) {
+    pickle(vm, value, temporaryReplacement, stream);
+  } MOZART_CATCH(vm, kind, node) {
+    // The raise skips the destructor of buffer
+    buffer.release();
+    MOZART_RETHROW(vm);
+  } MOZART_ENDTRY(vm);
+
+  if (!buffer.finish() || !stream)
+    raiseError(vm, "zlib compression failed");
+#endif
+}
+
 } // namespace mozart
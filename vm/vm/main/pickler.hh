@@ -28,9 +28,48 @@
 #include "mozartcore.hh"
 
 #include <ostream>
+#include <streambuf>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace mozart {
 
+//////////////////////
+// Compressed format //
+//////////////////////
+
+/** Compression of the whole pickle stream */
+enum class PickleCompression {
+  none, zlib
+};
+
+struct PickleOptions {
+  PickleOptions(): compression(PickleCompression::none), level(6) {}
+
+  PickleCompression compression;
+  int level; // from 1 (fastest) to 9 (best ratio)
+};
+
+/** Whether this build supports the given compression method */
+bool isPickleCompressionSupported(PickleCompression compression);
+
+/*
+ * A compressed pickle starts with 0xFF 'O' 'Z' and a byte identifying the
+ * compression method, followed by the compressed raw pickle.
+ * A raw pickle starts with its node count, whose first byte is never 0xFF
+ * in practice.
+ */
+const size_t compressedPickleHeaderSize = 4;
+const unsigned char zlibPickleMethod = 'z';
+
+/** Whether the given bytes start with the header of a compressed pickle */
+inline
+bool isCompressedPickle(const unsigned char* data, size_t size) {
+  return size >= compressedPickleHeaderSize &&
+    data[0] == 0xFF && data[1] == 'O' && data[2] == 'Z';
+}
+
 /////////////
 // Pickler //
 /////////////
@@ -40,7 +79,25 @@ private:
   struct PickleNode {
     nativeint index;
     RichNode node;
+    unsigned char type;  // pickle type id
+    bool written;
+
+    // Generic route: the record returned by serialize()
     StableNode* refs;
+
+    // Direct route: range of the indices of the children in childRefs
+    size_t firstRef;
+    size_t refCount;
+  };
+
+  /** Hash of the (redirected) label and features of an arity */
+  struct ArityKeyHash {
+    size_t operator()(const std::vector<nativeint>& key) const {
+      size_t result = key.size();
+      for (nativeint index : key)
+        result = result * 31 + std::hash<nativeint>()(index);
+      return result;
+    }
   };
 
 public:
@@ -53,28 +110,39 @@ public:
   void pickle(RichNode value, RichNode temporaryReplacement);
 
 private:
-  void writeValues(VMAllocatedList<PickleNode>& nodes);
-  void writeArities(VMAllocatedList<PickleNode>& nodes);
-  void writeOthers(VMAllocatedList<PickleNode>& nodes);
-
-  bool findFeature(NodeDictionary& existingFeatures,
-                   nativeint index, RichNode node);
-  bool findBuiltin(NodeDictionary& existingBuiltins,
-                   nativeint index, RichNode refsTuple);
-  bool findArity(NodeDictionary& existingsArities,
-                 nativeint index, RichNode node, RichNode refsTuple);
-
-  void writeNode(nativeint index, RichNode node, RichNode refs);
+  void pickleReplaced(RichNode value);
+  void releaseTables();
+
+  nativeint indexOf(RichNode node);
+  bool serializeDirect(size_t position);
+  void addRef(RichNode child);
+  void addRefs(StaticArray<StableNode> children, size_t count);
+
+  void writeValues();
+  void writeArities();
+  void writeOthers();
+
+  bool findFeature(nativeint index, RichNode node);
+  bool findBuiltin(nativeint index, RichNode node);
+  bool findArity(PickleNode& pickleNode);
+  bool findWritten(nativeint written, nativeint index);
+
+  void writeNode(PickleNode& pickleNode);
+  void writeDirectNode(PickleNode& pickleNode);
+  void writeSerializedNode(nativeint id, RichNode node, RichNode refsTuple);
   void writeByte(unsigned char byte);
   void writeSize(size_t size);
   void writeSize(RichNode ref);
   void writeStr(const char* str, size_t len);
+  void writeAtom(atom_t atom);
   void writeAtom(RichNode atom);
   void writeAsVS(RichNode node);
+  void writeRef(nativeint ref);
   void writeRef(RichNode ref);
   void writeNRefs(RichNode refs, size_t n);
   void writeRefs(RichNode refs);
   void writeRefsLastFirst(RichNode refsTuple);
+  void writeDirectRefsLastFirst(PickleNode& pickleNode);
   void writeUUIDOf(RichNode node);
 
 private:
@@ -85,7 +153,18 @@ private:
 private:
   VM vm;
   std::ostream& output;
+  std::vector<PickleNode> nodes;
+  std::vector<nativeint> childRefs;
+  std::unordered_map<Node*, nativeint> indices;
   StaticArray<nativeint> redirections;
+
+  // Already written values, to share them in the pickle
+  std::unordered_map<const char*, nativeint> writtenAtoms;
+  std::unordered_map<nativeint, nativeint> writtenInts;
+  NodeDictionary writtenOtherFeatures;
+  std::unordered_map<builtins::BaseBuiltin*, nativeint> writtenBuiltins;
+  std::unordered_map<std::vector<nativeint>, nativeint,
+                     ArityKeyHash> writtenArities;
 };
 
 /////////////////
@@ -103,6 +182,73 @@ void pickle(VM vm, RichNode value, std::ostream& output) {
   pickle(vm, value, temporaryReplacement, output);
 }
 
+/**
+ * Pickle a value, possibly compressing the output
+ * A compressed pickle is deflated as it is written, through buffers of a
+ * fixed size.
+ */
+void pickle(VM vm, RichNode value, RichNode temporaryReplacement,
+            const PickleOptions& options, std::ostream& output);
+
+namespace internal {
+  /** Stream buffer that appends what is written to a string */
+  class StringAppendBuffer: public std::streambuf {
+  public:
+    explicit StringAppendBuffer(std::string& output): output(output) {
+      setp(buffer, buffer + sizeof(buffer));
+    }
+
+  protected:
+    int_type overflow(int_type ch) {
+      sync();
+      if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(ch);
+        pbump(1);
+      }
+      return traits_type::not_eof(ch);
+    }
+
+    int sync() {
+      output.append(pbase(), pptr() - pbase());
+      setp(buffer, buffer + sizeof(buffer));
+      return 0;
+    }
+
+  private:
+    std::string& output;
+    char buffer[4096];
+  };
+}
+
+/**
+ * Pickle a value at the end of a string
+ * Unlike going through an std::ostringstream, this does not make a copy of
+ * the whole pickle at the end.
+ */
+inline
+void pickle(VM vm, RichNode value, RichNode temporaryReplacement,
+            std::string& output) {
+  internal::StringAppendBuffer buffer(output);
+  std::ostream stream(&buffer);
+  pickle(vm, value, temporaryReplacement, stream);
+  stream.flush();
+}
+
+inline
+void pickle(VM vm, RichNode value, RichNode temporaryReplacement,
+            const PickleOptions& options, std::string& output) {
+  internal::StringAppendBuffer buffer(output);
+  std::ostream stream(&buffer);
+  pickle(vm, value, temporaryReplacement, options, stream);
+  stream.flush();
+}
+
+inline
+void pickle(VM vm, RichNode value, std::string& output) {
+  auto temporaryReplacement = Atom::build(vm, vm->coreatoms.nil);
+  pickle(vm, value, temporaryReplacement, output);
+}
+
 }
 
 #endif // MOZART_PICKLER_H
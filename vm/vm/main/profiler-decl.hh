@@ -0,0 +1,205 @@
+// Copyright © 2014, Université catholique de Louvain
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// *  Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// *  Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MOZART_PROFILER_DECL_H
+#define MOZART_PROFILER_DECL_H
+
+#include "core-forward-decl.hh"
+
+#include "store-decl.hh"
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mozart {
+
+class ThreadStack;
+
+//////////////
+// Profiler //
+//////////////
+
+/**
+ * Sampling profiler of Oz procedures
+ * While it is running, the emulator records the call stack of the running
+ * thread at the first call after each preemption tick. When it is stopped,
+ * the only cost is a test in the preemption path.
+ */
+class Profiler {
+public:
+  /** Deeper stacks are truncated to their innermost frames */
+  static constexpr size_t maxSampleDepth = 128;
+
+  struct ProcedureCounts {
+    ProcedureCounts(): self(0), total(0) {}
+
+    size_t self;  // samples where the procedure was running
+    size_t total; // samples where the procedure was on the stack
+  };
+
+public:
+  Profiler(): _running(false), _sampleCount(0) {}
+
+  bool isRunning() {
+    return _running;
+  }
+
+  /** Start sampling, discarding previous samples */
+  void start() {
+    _frameNames.clear();
+    _frameIndices.clear();
+    _stacks.clear();
+    _sampleCount = 0;
+    _running = true;
+  }
+
+  void stop() {
+    _running = false;
+  }
+
+  size_t getSampleCount() {
+    return _sampleCount;
+  }
+
+  /**
+   * Record a sample
+   * @param abstraction  Procedure being called by the running thread
+   * @param stack        Frames of the running thread
+   */
+  void sample(VM vm, StableNode* abstraction, ThreadStack& stack);
+
+  /**
+   * Samples in the collapsed-stack format of flame graphs: one line
+   * "outer;...;inner count" per distinct stack
+   */
+  std::string getCollapsedStacks();
+
+  /** Samples aggregated per procedure, by frame name */
+  std::map<std::string, ProcedureCounts> getProcedureCounts();
+
+  /** Name of a procedure in the profiles: "name (file:line)" */
+  static std::string getFrameName(VM vm, RichNode abstraction);
+
+private:
+  size_t frameIndex(VM vm, RichNode abstraction);
+
+  bool _running;
+  size_t _sampleCount;
+
+  // Distinct frame names, and stacks of indices in them, outermost first
+  std::vector<std::string> _frameNames;
+  std::unordered_map<std::string, size_t> _frameIndices;
+  std::map<std::vector<size_t>, size_t> _stacks;
+};
+
+////////////////////////
+// AllocationProfiler //
+////////////////////////
+
+/**
+ * Sampling profiler of the allocations of Oz procedures
+ * While it is running, the memory manager calls sample() about every
+ * `interval` bytes allocated, and the sample is attributed to the call stack
+ * of the running thread. The profile is written in the protobuf format of
+ * pprof.
+ */
+class AllocationProfiler {
+public:
+  AllocationProfiler():
+    _interval(0), _sampleCount(0), _abstraction(nullptr), _stack(nullptr) {}
+
+  bool isRunning() {
+    return _interval != 0;
+  }
+
+  /** Start sampling every `interval` bytes, discarding previous samples */
+  void start(VM vm, size_t interval);
+
+  void stop(VM vm);
+
+  size_t getInterval() {
+    return _interval;
+  }
+
+  size_t getSampleCount() {
+    return _sampleCount;
+  }
+
+  /**
+   * Tell which thread runs, for the duration of Thread::run()
+   * @param abstraction  Variable holding the procedure being executed
+   * @param stack        Frames of the running thread
+   */
+  void enterThread(StableNode* const* abstraction, ThreadStack* stack) {
+    _abstraction = abstraction;
+    _stack = stack;
+  }
+
+  void leaveThread() {
+    _abstraction = nullptr;
+    _stack = nullptr;
+  }
+
+  /**
+   * Record a sample, called by the memory manager
+   * This must not allocate in the heap, so the procedures are only looked up
+   * by resolve().
+   */
+  void sample(VM vm);
+
+  /** Look up the procedures of the samples, before the GC moves them */
+  void resolve(VM vm);
+
+  /** Samples as a profile.proto message of pprof */
+  std::string getPprofProfile(VM vm);
+
+private:
+  struct Procedure {
+    std::string name;
+    std::string file;
+    nativeint line;
+  };
+
+  size_t procedureIndex(VM vm, RichNode abstraction);
+
+  size_t _interval;
+  size_t _sampleCount;
+
+  StableNode* const* _abstraction;
+  ThreadStack* _stack;
+
+  // Samples not resolved yet, innermost frame first
+  std::vector<std::vector<StableNode*>> _pending;
+
+  // Distinct procedures, and stacks of indices in them, innermost first
+  std::vector<Procedure> _procedures;
+  std::unordered_map<std::string, size_t> _procedureIndices;
+  std::map<std::vector<size_t>, size_t> _stacks;
+};
+
+}
+
+#endif // MOZART_PROFILER_DECL_H
@@ -0,0 +1,343 @@
+// Copyright © 2014, Université catholique de Louvain
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// *  Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// *  Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "mozart.hh"
+
+#include <algorithm>
+#include <set>
+#include <sstream>
+
+namespace mozart {
+
+namespace {
+  /**
+   * Print name, file and line of a procedure, from its debug data
+   * The line is -1 when the location is unknown.
+   */
+  void getProcedureInfo(VM vm, RichNode abstraction, atom_t& printName,
+                        std::string& file, nativeint& line) {
+    printName = vm->coreatoms.empty;
+    UnstableNode fileNode, lineNode;
+
+    MOZART_TRY(vm) {
+      UnstableNode debugData;
+      Callable(abstraction).getDebugInfo(vm, printName, debugData);
+
+      Dottable dotDebugData(debugData);
+      fileNode = dotDebugData.condSelect(vm, "file", vm->coreatoms.empty);
+      lineNode = dotDebugData.condSelect(vm, "line", unit);
+    } MOZART_CATCH(vm, kind, node) {
+      fileNode = build(vm, vm->coreatoms.empty);
+      lineNode = build(vm, unit);
+    } MOZART_ENDTRY(vm);
+
+    if (RichNode(fileNode).is<Atom>() && RichNode(lineNode).is<SmallInt>()) {
+      atom_t fileAtom = RichNode(fileNode).as<Atom>().value();
+      file.assign(fileAtom.contents(), fileAtom.length());
+      line = RichNode(lineNode).as<SmallInt>().value();
+    } else {
+      file.clear();
+      line = -1;
+    }
+  }
+
+  /** Writer of the protobuf wire format, enough for profile.proto */
+  class ProtobufWriter {
+  public:
+    void varint(std::uint64_t value) {
+      while (value >= 0x80) {
+        _output.push_back((char) (value | 0x80));
+        value >>= 7;
+      }
+      _output.push_back((char) value);
+    }
+
+    void intField(int field, std::int64_t value) {
+      varint(field << 3);
+      varint((std::uint64_t) value);
+    }
+
+    void bytesField(int field, const std::string& value) {
+      varint((field << 3) | 2);
+      varint(value.size());
+      _output += value;
+    }
+
+    void messageField(int field, const ProtobufWriter& message) {
+      bytesField(field, message._output);
+    }
+
+    void packedField(int field, const std::vector<std::uint64_t>& values) {
+      ProtobufWriter packed;
+      for (auto value : values)
+        packed.varint(value);
+      messageField(field, packed);
+    }
+
+    const std::string& get() {
+      return _output;
+    }
+  private:
+    std::string _output;
+  };
+}
+
+//////////////
+// Profiler //
+//////////////
+
+constexpr size_t Profiler::maxSampleDepth;
+
+void Profiler::sample(VM vm, StableNode* abstraction, ThreadStack& stack) {
+  std::vector<size_t> frames;
+  frames.push_back(frameIndex(vm, *abstraction));
+
+  for (auto iter = stack.begin(); iter != stack.end(); ++iter) {
+    if (frames.size() == maxSampleDepth)
+      break;
+    if (!iter->isExceptionHandler())
+      frames.push_back(frameIndex(vm, *iter->abstraction));
+  }
+
+  std::reverse(frames.begin(), frames.end());
+  _stacks[frames]++;
+  _sampleCount++;
+}
+
+std::string Profiler::getFrameName(VM vm, RichNode abstraction) {
+  atom_t printName;
+  std::string file;
+  nativeint line;
+  getProcedureInfo(vm, abstraction, printName, file, line);
+
+  std::stringstream name;
+  if (printName == vm->coreatoms.empty)
+    name << "<anonymous>";
+  else
+    name.write(printName.contents(), printName.length());
+  if (line >= 0)
+    name << " (" << file << ":" << line << ")";
+
+  return name.str();
+}
+
+size_t Profiler::frameIndex(VM vm, RichNode abstraction) {
+  // ';' separates the frames in the collapsed-stack format
+  std::string result = getFrameName(vm, abstraction);
+  std::replace(result.begin(), result.end(), ';', ':');
+
+  auto inserted = _frameIndices.emplace(result, _frameNames.size());
+  if (inserted.second)
+    _frameNames.push_back(result);
+  return inserted.first->second;
+}
+
+std::string Profiler::getCollapsedStacks() {
+  std::stringstream result;
+
+  for (auto& stack : _stacks) {
+    bool first = true;
+    for (size_t frame : stack.first) {
+      if (!first)
+        result << ';';
+      result << _frameNames[frame];
+      first = false;
+    }
+    result << ' ' << stack.second << '\n';
+  }
+
+  return result.str();
+}
+
+std::map<std::string, Profiler::ProcedureCounts>
+Profiler::getProcedureCounts() {
+  std::map<std::string, ProcedureCounts> result;
+
+  for (auto& stack : _stacks) {
+    result[_frameNames[stack.first.back()]].self += stack.second;
+
+    // Recursive procedures count once per sample
+    std::set<size_t> onStack(stack.first.begin(), stack.first.end());
+    for (size_t frame : onStack)
+      result[_frameNames[frame]].total += stack.second;
+  }
+
+  return result;
+}
+
+////////////////////////
+// AllocationProfiler //
+////////////////////////
+
+void AllocationProfiler::start(VM vm, size_t interval) {
+  _pending.clear();
+  _procedures.clear();
+  _procedureIndices.clear();
+  _stacks.clear();
+  _sampleCount = 0;
+  _interval = interval;
+
+  vm->getMemoryManager().setSampleInterval(interval);
+}
+
+void AllocationProfiler::stop(VM vm) {
+  vm->getMemoryManager().setSampleInterval(0);
+  _interval = 0;
+
+  resolve(vm);
+}
+
+void AllocationProfiler::sample(VM vm) {
+  // Allocations outside of the emulator, e.g., by the GC, are not sampled
+  if (_abstraction == nullptr || *_abstraction == nullptr)
+    return;
+
+  _pending.emplace_back();
+  auto& frames = _pending.back();
+  frames.push_back(*_abstraction);
+
+  for (auto iter = _stack->begin(); iter != _stack->end(); ++iter) {
+    if (frames.size() == Profiler::maxSampleDepth)
+      break;
+    if (!iter->isExceptionHandler())
+      frames.push_back(iter->abstraction);
+  }
+
+  _sampleCount++;
+}
+
+void AllocationProfiler::resolve(VM vm) {
+  if (_pending.empty())
+    return;
+
+  // Looking up the procedures allocates, and may add samples meanwhile
+  auto pending = std::move(_pending);
+  _pending.clear();
+
+  std::unordered_map<StableNode*, size_t> indices;
+  for (auto& frames : pending) {
+    std::vector<size_t> stack;
+    for (StableNode* abstraction : frames) {
+      auto found = indices.find(abstraction);
+      if (found == indices.end()) {
+        found = indices.emplace(
+          abstraction, procedureIndex(vm, *abstraction)).first;
+      }
+      stack.push_back(found->second);
+    }
+    _stacks[stack]++;
+  }
+}
+
+size_t AllocationProfiler::procedureIndex(VM vm, RichNode abstraction) {
+  atom_t printName;
+  Procedure procedure;
+  getProcedureInfo(vm, abstraction, printName, procedure.file, procedure.line);
+
+  if (printName == vm->coreatoms.empty)
+    procedure.name = "<anonymous>";
+  else
+    procedure.name.assign(printName.contents(), printName.length());
+
+  std::stringstream key;
+  key << procedure.name << '\0' << procedure.file << '\0' << procedure.line;
+
+  auto inserted = _procedureIndices.emplace(key.str(), _procedures.size());
+  if (inserted.second)
+    _procedures.push_back(std::move(procedure));
+  return inserted.first->second;
+}
+
+std::string AllocationProfiler::getPprofProfile(VM vm) {
+  resolve(vm);
+
+  // See profile.proto in the pprof sources for the field numbers
+
+  std::vector<std::string> strings;
+  std::unordered_map<std::string, size_t> stringIndices;
+  auto stringIndex = [&] (const std::string& str) -> std::int64_t {
+    auto inserted = stringIndices.emplace(str, strings.size());
+    if (inserted.second)
+      strings.push_back(str);
+    return inserted.first->second;
+  };
+  stringIndex("");
+
+  auto valueType = [&] (const char* type, const char* unit) {
+    ProtobufWriter result;
+    result.intField(1, stringIndex(type));
+    result.intField(2, stringIndex(unit));
+    return result;
+  };
+
+  ProtobufWriter profile;
+  profile.messageField(1, valueType("samples", "count"));
+  profile.messageField(1, valueType("alloc_space", "bytes"));
+
+  // Each sample stands for the interval it was taken in
+  std::uint64_t interval = _interval;
+  for (auto& stack : _stacks) {
+    std::vector<std::uint64_t> locations;
+    for (size_t procedure : stack.first)
+      locations.push_back(procedure + 1);
+
+    ProtobufWriter sample;
+    sample.packedField(1, locations);
+    sample.packedField(2, { stack.second, stack.second * interval });
+    profile.messageField(2, sample);
+  }
+
+  // One location and one function per procedure, with the same ids
+  for (size_t i = 0; i < _procedures.size(); i++) {
+    auto& procedure = _procedures[i];
+
+    ProtobufWriter line;
+    line.intField(1, i + 1);
+    line.intField(2, std::max<nativeint>(procedure.line, 0));
+
+    ProtobufWriter location;
+    location.intField(1, i + 1);
+    location.messageField(4, line);
+    profile.messageField(4, location);
+
+    ProtobufWriter function;
+    function.intField(1, i + 1);
+    function.intField(2, stringIndex(procedure.name));
+    function.intField(3, stringIndex(procedure.name));
+    function.intField(4, stringIndex(procedure.file));
+    function.intField(5, std::max<nativeint>(procedure.line, 0));
+    profile.messageField(5, function);
+  }
+
+  profile.messageField(11, valueType("alloc_space", "bytes"));
+  profile.intField(12, interval);
+
+  // The string table is complete only now, fields may come in any order
+  for (auto& str : strings)
+    profile.bytesField(6, str);
+
+  return profile.get();
+}
+
+}
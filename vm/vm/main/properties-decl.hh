@@ -189,6 +189,9 @@ public:
     size_t maxGCThreshold;
     size_t gcThresholdTolerance;
     bool autoGC;
+
+    // Pickles
+    bool parallelUnpickle;
   } config;
 
   struct {
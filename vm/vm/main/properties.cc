@@ -54,6 +54,10 @@ PropertyRegistry::PropertyRegistry(VirtualMachineOptions options) {
   computeMaxGCThreshold();
   config.autoGC = true;
 
+  // Pickles
+
+  config.parallelUnpickle = false;
+
   // Memory usage statistics
 
   stats.activeMemory = 0;
@@ -143,6 +147,52 @@ void PropertyRegistry::registerPredefined(VM vm) {
 
   registerValueProp(vm, "gc.codeCycles", 1); // compatibility, ignored
 
+  // Pauses are in microseconds, the history holds the last GCs, oldest first
+  registerReadOnlyProp<UnstableNode>(vm, "gc.stats",
+    [] (VM vm) -> UnstableNode {
+      return vm->getGCStatistics().buildStats(vm);
+    });
+
+  registerReadOnlyProp<UnstableNode>(vm, "gc.history",
+    [] (VM vm) -> UnstableNode {
+      OzListBuilder history(vm);
+      for (auto& event : vm->getGCStatistics().getHistory())
+        history.push_back(vm, GCStatistics::buildEvent(vm, event));
+      return history.get(vm);
+    });
+
+  // Stream of the future GC events, extended after each GC
+  registerConstantProp(vm, "gc.events", ReadOnlyVariable::build(vm));
+
+  // Take a census of the heap at each GC, see Profile.getHeapCensus
+  registerReadWriteProp<bool>(vm, "gc.census",
+    [] (VM vm) {
+      return vm->getHeapCensus().isEnabled();
+    },
+    [] (VM vm, bool value) {
+      vm->getHeapCensus().setEnabled(value);
+    }
+  );
+
+  // Enter Oz procedures through trampolines listed in /tmp/perf-<pid>.map,
+  // so that Linux perf attributes time to them; stays false if unsupported.
+  // While it is on, Thread::run() leaves emulate() at every call and return,
+  // saving the frame, and enters it again through the next trampoline, so
+  // profiles taken this way include the cost of these round trips.
+  registerReadWriteProp<bool>(vm, "perf.map",
+    [] (VM vm) {
+      return vm->getPerfMap().isEnabled();
+    },
+    [] (VM vm, bool value) {
+      vm->getPerfMap().setEnabled(value);
+    }
+  );
+
+  // Predecode the numbers and byte-code of large pickle files and boot
+  // images on several threads; off by default, since the extra scan only
+  // pays off when other cores are idle
+  registerReadWriteProp(vm, "pickle.parallel", config.parallelUnpickle);
+
   // Memory usage statistics - most are irrelevant in Mozart 2
 
   registerReadOnlyProp<nativeint>(vm, "memory.freelist",
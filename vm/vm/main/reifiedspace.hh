@@ -117,7 +117,7 @@ private:
 #include "ReifiedSpace-implem.hh"
 
 void ReifiedSpace::create(SpaceRef& self, VM vm, GR gr, ReifiedSpace from) {
-  gr->copySpace(self, from.home());
+  gr->copySpace(self, from.getSpace());
 }
 
 UnstableNode ReifiedSpace::askSpace(RichNode self, VM vm) {
@@ -103,6 +103,11 @@ public:
     return _space;
   }
 
+  /** Identifier of the thread, kept across GCs */
+  std::uint64_t getId() {
+    return _id;
+  }
+
   ThreadPriority getPriority() { return _priority; }
 
   inline
@@ -173,6 +178,7 @@ private:
   friend class RunnableList;
 
   SpaceRef _space;
+  std::uint64_t _id;
 
   ThreadPriority _priority;
 
@@ -96,7 +96,7 @@ void IntermediateState::rewind(VM vm) {
 //////////////
 
 Runnable::Runnable(VM vm, Space* space, ThreadPriority priority) :
-  vm(vm), _space(space), _priority(priority),
+  vm(vm), _space(space), _id(vm->newThreadId()), _priority(priority),
   _runnable(false), _terminated(false), _dead(false),
   _raiseOnBlock(false), _intermediateState(vm),
   _replicate(nullptr) {
@@ -113,6 +113,10 @@ Runnable::Runnable(GR gr, Runnable& from) :
   _replicate(nullptr) {
 
   gr->copySpace(_space, from._space);
+  if (gr->kind() == GraphReplicator::grkGarbageCollection)
+    _id = from._id;
+  else
+    _id = vm->newThreadId();
   _priority = from._priority;
   _runnable = from._runnable;
   _terminated = from._terminated;
@@ -142,6 +146,9 @@ void Runnable::resume(bool skipSchedule) {
   _runnable = true;
   _space->notifyThreadResumed();
 
+  if (vm->getTracer().isEnabled())
+    vm->getTracer().traceResume(_id);
+
   if (!skipSchedule)
     vm->getThreadPool().schedule(this);
 }
@@ -162,6 +169,9 @@ void Runnable::suspendOnVar(VM vm, RichNode variable, bool skipUnschedule) {
 
   suspend(skipUnschedule);
 
+  if (vm->getTracer().isEnabled())
+    vm->getTracer().traceSuspend(_id, variable);
+
   DataflowVariable(variable).addToSuspendList(vm, _reification);
 }
 
@@ -258,6 +258,7 @@ private:
   friend struct StructuralDualWalk;
   friend class Serializer;
   friend class Pickler;
+  friend class Tracer;
 
   inline void reinit(VM vm, StableNode& from);
   inline void reinit(VM vm, UnstableNode& from);
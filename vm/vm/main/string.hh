@@ -160,8 +160,7 @@ void String::stringSearch(RichNode self, VM vm, RichNode from,
       raiseUnicodeError(vm, haystack.error, self);
   }
 
-  const char* foundIter = std::search(haystack.begin(), haystack.end(),
-                                      needle->begin(), needle->end());
+  const char* foundIter = searchLString(haystack, *needle);
 
   // Make result
   if (foundIter == haystack.end()) {
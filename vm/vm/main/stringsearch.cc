@@ -0,0 +1,130 @@
+// Copyright © 2014, Université catholique de Louvain
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// *  Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// *  Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "mozart.hh"
+
+#ifdef MOZART_X86_SIMD_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace mozart {
+
+/////////////////////////
+// Byte search kernels //
+/////////////////////////
+
+namespace internal {
+
+namespace {
+  const unsigned char* findAnyByteScalar(const unsigned char* begin,
+                                         const unsigned char* end,
+                                         const unsigned char* bytes,
+                                         size_t byteCount) {
+    if (byteCount == 1) {
+      auto found = std::memchr(begin, bytes[0], end - begin);
+      return found ? static_cast<const unsigned char*>(found) : end;
+    }
+
+    for (const unsigned char* cur = begin; cur < end; ++cur) {
+      for (size_t i = 0; i < byteCount; ++i) {
+        if (*cur == bytes[i])
+          return cur;
+      }
+    }
+    return end;
+  }
+
+#ifdef MOZART_X86_SIMD_KERNELS
+
+  __attribute__((target("sse2")))
+  const unsigned char* findAnyByteSSE2(const unsigned char* begin,
+                                       const unsigned char* end,
+                                       const unsigned char* bytes,
+                                       size_t byteCount) {
+    __m128i patterns[maxFindAnyBytes];
+    for (size_t i = 0; i < byteCount; ++i)
+      patterns[i] = _mm_set1_epi8((char) bytes[i]);
+
+    const unsigned char* cur = begin;
+    for (; end - cur >= 16; cur += 16) {
+      __m128i chunk = _mm_loadu_si128((const __m128i*) cur);
+      __m128i matches = _mm_cmpeq_epi8(chunk, patterns[0]);
+      for (size_t i = 1; i < byteCount; ++i)
+        matches = _mm_or_si128(matches, _mm_cmpeq_epi8(chunk, patterns[i]));
+      unsigned int mask = (unsigned int) _mm_movemask_epi8(matches);
+      if (mask != 0)
+        return cur + __builtin_ctz(mask);
+    }
+    return findAnyByteScalar(cur, end, bytes, byteCount);
+  }
+
+  __attribute__((target("avx2")))
+  const unsigned char* findAnyByteAVX2(const unsigned char* begin,
+                                       const unsigned char* end,
+                                       const unsigned char* bytes,
+                                       size_t byteCount) {
+    __m256i patterns[maxFindAnyBytes];
+    for (size_t i = 0; i < byteCount; ++i)
+      patterns[i] = _mm256_set1_epi8((char) bytes[i]);
+
+    const unsigned char* cur = begin;
+    for (; end - cur >= 32; cur += 32) {
+      __m256i chunk = _mm256_loadu_si256((const __m256i*) cur);
+      __m256i matches = _mm256_cmpeq_epi8(chunk, patterns[0]);
+      for (size_t i = 1; i < byteCount; ++i)
+        matches = _mm256_or_si256(matches,
+                                  _mm256_cmpeq_epi8(chunk, patterns[i]));
+      unsigned int mask = (unsigned int) _mm256_movemask_epi8(matches);
+      if (mask != 0)
+        return cur + __builtin_ctz(mask);
+    }
+    return findAnyByteSSE2(cur, end, bytes, byteCount);
+  }
+
+#endif // MOZART_X86_SIMD_KERNELS
+}
+
+const unsigned char* findAnyByte(const unsigned char* begin,
+                                 const unsigned char* end,
+                                 const unsigned char* bytes,
+                                 size_t byteCount, SIMDLevel level) {
+  assert(byteCount <= maxFindAnyBytes);
+  if (byteCount == 0)
+    return end;
+
+  switch (level) {
+#ifdef MOZART_X86_SIMD_KERNELS
+    case SIMDLevel::avx2:
+      return findAnyByteAVX2(begin, end, bytes, byteCount);
+    case SIMDLevel::sse2:
+      return findAnyByteSSE2(begin, end, bytes, byteCount);
+#endif
+    default:
+      return findAnyByteScalar(begin, end, bytes, byteCount);
+  }
+}
+
+}
+
+}
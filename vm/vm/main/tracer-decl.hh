@@ -0,0 +1,142 @@
+// Copyright © 2014, Université catholique de Louvain
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// *  Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// *  Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MOZART_TRACER_DECL_H
+#define MOZART_TRACER_DECL_H
+
+#include "core-forward-decl.hh"
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace mozart {
+
+////////////////
+// TraceEvent //
+////////////////
+
+struct TraceEvent {
+  enum Kind {
+    tekRun,      // a thread ran for a quantum
+    tekGC,       // a garbage collection
+    tekAlarm,    // an alarm fired
+    tekSuspend,  // a thread blocked on a variable
+    tekResume    // a thread became runnable again
+  };
+
+  Kind kind;
+  std::int64_t time;      // in microseconds since the trace was started
+  std::int64_t duration;  // in microseconds, for tekRun and tekGC
+  std::uint64_t thread;   // id of the thread, or 0 for the VM itself
+  const void* object;     // variable for tekSuspend
+  const char* detail;     // type of the variable for tekSuspend
+};
+
+////////////
+// Tracer //
+////////////
+
+/**
+ * Timeline of the scheduling of threads and of the GCs of a VM
+ * The events are recorded in a fixed-size ring buffer, so that a long trace
+ * keeps the most recent ones. Only the thread of the VM writes in it, hence
+ * there is no locking. When the tracer is stopped, the hooks only cost a
+ * test of isEnabled().
+ */
+class Tracer {
+public:
+  Tracer(): _enabled(false), _count(0) {}
+
+  bool isEnabled() {
+    return _enabled;
+  }
+
+  /** Start tracing, in a buffer of `capacity` events */
+  void start(size_t capacity);
+
+  void stop() {
+    _enabled = false;
+  }
+
+  /** Number of events recorded, including those that were overwritten */
+  size_t getEventCount() {
+    return _count;
+  }
+
+  /** Current time, in microseconds since start() */
+  std::int64_t now() {
+    using namespace std::chrono;
+    return duration_cast<microseconds>(steady_clock::now() - _start).count();
+  }
+
+  void traceRun(std::uint64_t thread, std::int64_t startTime) {
+    record(TraceEvent::tekRun, startTime, now() - startTime, thread);
+  }
+
+  void traceGC(std::int64_t startTime) {
+    record(TraceEvent::tekGC, startTime, now() - startTime, 0);
+  }
+
+  void traceAlarm() {
+    record(TraceEvent::tekAlarm, now(), 0, 0);
+  }
+
+  void traceSuspend(std::uint64_t thread, RichNode variable);
+
+  void traceResume(std::uint64_t thread) {
+    record(TraceEvent::tekResume, now(), 0, thread);
+  }
+
+  /** The buffered events, oldest first */
+  std::vector<TraceEvent> getEvents();
+
+  /** Write the buffered events in the JSON format of Chrome's about:tracing */
+  void dumpChromeTrace(std::ostream& output);
+
+private:
+  TraceEvent& record(TraceEvent::Kind kind, std::int64_t time,
+                     std::int64_t duration, std::uint64_t thread) {
+    TraceEvent& event = _events[_count % _events.size()];
+    _count++;
+
+    event.kind = kind;
+    event.time = time;
+    event.duration = duration;
+    event.thread = thread;
+    event.object = nullptr;
+    event.detail = nullptr;
+    return event;
+  }
+
+  bool _enabled;
+  std::chrono::steady_clock::time_point _start;
+  std::vector<TraceEvent> _events;
+  size_t _count;
+};
+
+}
+
+#endif // MOZART_TRACER_DECL_H
@@ -0,0 +1,110 @@
+// Copyright © 2014, Université catholique de Louvain
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// *  Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// *  Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#include "mozart.hh"
+
+#include <set>
+
+namespace mozart {
+
+////////////
+// Tracer //
+////////////
+
+void Tracer::start(size_t capacity) {
+  _events.assign(std::max<size_t>(capacity, 1), TraceEvent());
+  _count = 0;
+  _start = std::chrono::steady_clock::now();
+  _enabled = true;
+}
+
+void Tracer::traceSuspend(std::uint64_t thread, RichNode variable) {
+  TraceEvent& event = record(TraceEvent::tekSuspend, now(), 0, thread);
+  event.object = variable.node();
+  event.detail = variable.type()->getName().c_str();
+}
+
+std::vector<TraceEvent> Tracer::getEvents() {
+  std::vector<TraceEvent> result;
+  size_t first = (_count > _events.size()) ? _count - _events.size() : 0;
+  for (size_t i = first; i < _count; i++)
+    result.push_back(_events[i % _events.size()]);
+  return result;
+}
+
+void Tracer::dumpChromeTrace(std::ostream& output) {
+  auto events = getEvents();
+
+  output << "{\"traceEvents\":[\n";
+
+  // Name the tracks of the VM and of the threads
+  std::set<std::uint64_t> threads;
+  threads.insert(0);
+  for (auto& event : events)
+    threads.insert(event.thread);
+
+  bool first = true;
+  for (auto thread : threads) {
+    output << (first ? "" : ",\n")
+           << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+           << thread << ",\"args\":{\"name\":\"";
+    if (thread == 0)
+      output << "VM";
+    else
+      output << "Thread " << thread;
+    output << "\"}}";
+    first = false;
+  }
+
+  for (auto& event : events) {
+    output << ",\n{\"pid\":1,\"tid\":" << event.thread
+           << ",\"ts\":" << event.time;
+
+    switch (event.kind) {
+      case TraceEvent::tekRun:
+        output << ",\"ph\":\"X\",\"name\":\"run\",\"dur\":" << event.duration;
+        break;
+      case TraceEvent::tekGC:
+        output << ",\"ph\":\"X\",\"name\":\"gc\",\"dur\":" << event.duration;
+        break;
+      case TraceEvent::tekAlarm:
+        output << ",\"ph\":\"i\",\"s\":\"t\",\"name\":\"alarm\"";
+        break;
+      case TraceEvent::tekSuspend:
+        output << ",\"ph\":\"i\",\"s\":\"t\",\"name\":\"suspend\""
+               << ",\"args\":{\"variable\":\"" << event.detail << "@"
+               << event.object << "\"}";
+        break;
+      case TraceEvent::tekResume:
+        output << ",\"ph\":\"i\",\"s\":\"t\",\"name\":\"resume\"";
+        break;
+    }
+
+    output << "}";
+  }
+
+  output << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+}
@@ -24,6 +24,14 @@
 
 #include "mozart.hh"
 
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
+#ifdef USE_ZLIB
+#include <zlib.h>
+#endif
+
 namespace mozart {
 
 namespace {
@@ -53,29 +61,244 @@ namespace internal {
   }
 }
 
+/////////////////
+// Predecoding //
+/////////////////
+
+/** Input size from which parts of a pickle file are decoded in parallel */
+const size_t parallelUnpickleThreshold = 256 * 1024;
+
+/** Decode a big-endian size field */
+size_t decodeSize(const unsigned char* bytes) {
+  return ((size_t) bytes[0] << 24) | ((size_t) bytes[1] << 16) |
+    ((size_t) bytes[2] << 8) | (size_t) bytes[3];
+}
+
+/** Decode an integer, return false if it does not fit in a nativeint */
+bool decodeInt(const unsigned char* data, size_t length, nativeint& value) {
+  // Integers that fit are short, and need not be copied to the heap
+  char buffer[32];
+  std::string str;
+  const char* start = buffer;
+  if (length < sizeof(buffer)) {
+    std::copy(data, data + length, buffer);
+    buffer[length] = '\0';
+  } else {
+    str.assign(reinterpret_cast<const char*>(data), length);
+    start = str.c_str();
+  }
+
+  char* end = nullptr;
+  errno = 0; // reset errno since we need to know if strtoll() overflowed
+  value = internal::strto<nativeint>(start, &end, 10);
+  assert(*end == '\0' && "bad integer string");
+  return !((value == SmallInt::min() || value == SmallInt::max()) &&
+           errno == ERANGE);
+}
+
+double decodeFloat(const unsigned char* data, size_t length) {
+  std::string str(reinterpret_cast<const char*>(data), length);
+  char* end = nullptr;
+  double result = std::strtod(str.c_str(), &end);
+  assert(*end == '\0' && "bad float string");
+  return result;
+}
+
+/** Decode `count` big-endian instructions */
+void decodeCodeBlock(const unsigned char* data, size_t count,
+                     std::vector<ByteCode>& codeBlock) {
+  codeBlock.resize(count);
+  for (size_t i = 0; i < count; ++i)
+    codeBlock[i] = ((ByteCode) data[i*2] << 8) | (ByteCode) data[i*2+1];
+}
+
+/**
+ * Numbers and byte-code of a pickle decoded ahead of time, without touching
+ * the VM, so that this may be done by several threads at once
+ * They are stored by node index in a flat array. The slot of a node first
+ * points to the size field of its value in the input, and then holds the
+ * decoded value.
+ */
+class Predecoded {
+public:
+  enum Kind: unsigned char {
+    pkNone, pkInt, pkFloat, pkCodeBlock
+  };
+
+  explicit Predecoded(size_t nodeCount):
+    kinds(nodeCount, pkNone), slots(nodeCount) {}
+
+  /** Record a value to decode, return false if the node already has one */
+  bool add(size_t index, Kind kind, const unsigned char* sizeField) {
+    if (kinds[index] != pkNone)
+      return false;
+
+    kinds[index] = kind;
+    if (kind == pkCodeBlock) {
+      slots[index].codeBlock = codeBlocks.size();
+      codeBlocks.emplace_back(sizeField, std::vector<ByteCode>());
+    } else {
+      slots[index].data = sizeField;
+    }
+    return true;
+  }
+
+  /** Decode the values of the nodes in [from, to) */
+  void decode(size_t from, size_t to) {
+    for (size_t i = from; i < to; ++i) {
+      switch (kinds[i]) {
+        case pkInt: {
+          const unsigned char* field = slots[i].data;
+          nativeint value;
+          if (decodeInt(field + 4, decodeSize(field), value))
+            slots[i].intValue = value;
+          else
+            kinds[i] = pkNone; // a BigInt, built from the input later
+          break;
+        }
+        case pkFloat: {
+          const unsigned char* field = slots[i].data;
+          slots[i].floatValue = decodeFloat(field + 4, decodeSize(field));
+          break;
+        }
+        case pkCodeBlock: {
+          auto& block = codeBlocks[slots[i].codeBlock];
+          decodeCodeBlock(block.first + 4, decodeSize(block.first),
+                          block.second);
+          break;
+        }
+      }
+    }
+  }
+
+  size_t size() {
+    return kinds.size();
+  }
+
+  bool has(size_t index, Kind kind) {
+    return kinds[index] == kind;
+  }
+
+  nativeint intValue(size_t index) {
+    return slots[index].intValue;
+  }
+
+  double floatValue(size_t index) {
+    return slots[index].floatValue;
+  }
+
+  std::vector<ByteCode>& codeBlock(size_t index) {
+    return codeBlocks[slots[index].codeBlock].second;
+  }
+
+private:
+  union Slot {
+    const unsigned char* data;
+    nativeint intValue;
+    double floatValue;
+    size_t codeBlock;
+  };
+
+  // Threads decode disjoint ranges, and each kind is a byte of its own
+  std::vector<unsigned char> kinds;
+  std::vector<Slot> slots;
+
+  // Code areas are few, each one has its own buffer
+  std::vector<std::pair<const unsigned char*,
+                        std::vector<ByteCode>>> codeBlocks;
+};
+
 ///////////////
 // Unpickler //
 ///////////////
 
+/** Size from which byte strings may point into a shared input */
+const size_t externalByteStringThreshold = 4096;
+
+void MOZART_NORETURN raiseCorruptedPickle(VM vm) {
+  raiseError(vm, "dp", "generic", "unpickle:corrupted",
+             "Truncated or corrupted pickle", buildNil(vm));
+}
+
+/**
+ * Input of an Unpickler that is produced as it is read, such as the
+ * inflated contents of a compressed pickle
+ * Only a window of it is in memory at once.
+ */
+class UnpickleSource {
+public:
+  /**
+   * Make at least `length` bytes available from `current`, which points into
+   * the window, or is null at first. Both `current` and `end` are updated,
+   * since the bytes are moved to the start of the window.
+   * @return false if the input ends before, or is corrupted
+   */
+  virtual bool refill(const unsigned char*& current,
+                      const unsigned char*& end, size_t length) = 0;
+
+  /** Upper bound of the size of the input that follows the window */
+  virtual size_t maxRemaining() = 0;
+};
+
 class Unpickler {
 public:
-  Unpickler(VM vm, std::istream& input): vm(vm), input(input) {
+  Unpickler(VM vm, const unsigned char* data, size_t size,
+            bool lazyCode = false, bool parallel = false,
+            const std::shared_ptr<const void>& storage = nullptr):
+    vm(vm), current(data), end(data + size), source(nullptr),
+    lazyCode(lazyCode), parallel(parallel), storage(storage),
+    currentIndex(0) {
+  }
+
+  /**
+   * Unpickle from a source, whose values are neither shared nor predecoded
+   * since only a window of it is available
+   */
+  Unpickler(VM vm, UnpickleSource& source):
+    vm(vm), current(nullptr), end(nullptr), source(&source),
+    lazyCode(false), parallel(false), currentIndex(0) {
   }
 
   /** Top-level unpickle function */
   UnstableNode unpickle() {
+    UnstableNode result;
+    MOZART_TRY(vm) {
+      result = unpickleNodes();
+    } MOZART_CATCH(vm, kind, node) {
+      // The raise skips the destructors of the members
+      release();
+      MOZART_RETHROW(vm);
+    } MOZART_ENDTRY(vm);
+    return result;
+  }
+
+private:
+  UnstableNode unpickleNodes() {
     size_t count = readSize();
     size_t resultIndex = readSize();
+    if (resultIndex > count)
+      raiseCorrupted();
+
+    // Each node takes at least one byte of the input, be it its definition
+    // or a reference to it, so do not trust a count that would not fit
+    if (count > remaining())
+      raiseCorrupted();
 
     nodes.resize(count+1);
     for (auto& node: nodes)
       node = OptVar::build(vm);
 
+    if (parallel && remaining() >= parallelUnpickleThreshold &&
+        vm->getEnvironment().getParallelism() > 1)
+      predecode();
+
     while (true) {
       size_t index = readSize();
       if (index == 0)
         break;
+      checkIndex(index);
 
+      currentIndex = index;
       auto value = readValue();
       RichNode(nodes[index]).as<OptVar>().bind(vm, std::move(value));
     }
@@ -83,6 +306,13 @@ public:
     return std::move(nodes[resultIndex]);
   }
 
+  void release() {
+    std::vector<UnstableNode>().swap(nodes);
+    predecoded.reset();
+    storage.reset();
+  }
+
+public:
   /** Read a value */
   UnstableNode readValue() {
     auto kind = readByte();
@@ -108,35 +338,116 @@ public:
       case 19: return readNameValue();
       case 20: return readNamedNameValue();
       case 21: return readUnicodeStringValue();
-      default: {
-        assert(false && "invalid value kind");
-        std::cerr << "Invalid kind met while unpickling: " << (int)(kind) << std::endl;
-        std::abort();
-      }
+      case 22: return readPersistentMapValue();
+      case 23: return readByteStringValue();
+      default: raiseCorrupted();
     }
   }
 
 private:
+  /**
+   * Decode the numbers and the byte-code of the whole input on several
+   * threads, before the nodes are built by this one
+   */
+  void predecode() {
+    predecoded.reset(new Predecoded(nodes.size()));
+
+    const unsigned char* start = current;
+    while (true) {
+      size_t index = readSize();
+      if (index == 0)
+        break;
+      checkIndex(index);
+      scanValue(index);
+    }
+    current = start;
+
+    vm->getEnvironment().parallelFor(
+      predecoded->size(),
+      [this] (size_t from, size_t to) {
+        predecoded->decode(from, to);
+      });
+  }
+
+  /** Skip the value of a node, recording what can be predecoded */
+  void scanValue(size_t index) {
+    auto kind = readByte();
+    switch (kind) {
+      case 1: case 2: { // int, float
+        const unsigned char* sizeField = current;
+        ignore(readSize());
+        addPredecoded(index, kind == 1 ? Predecoded::pkInt :
+                      Predecoded::pkFloat, sizeField);
+        break;
+      }
+      case 3: ignore(1); break;
+      case 4: case 12: break;
+      case 5: case 18: case 21: case 23: ignore(readSize()); break;
+      case 6: ignore(4 + 4); break;
+      case 7: case 8: case 9: case 15: ignore(4); skipRefs(); break;
+      case 10: ignore(readSize()); ignore(readSize()); break;
+      case 11: { // code area
+        ignore(UUID::byte_count);
+        const unsigned char* sizeField = current;
+        ignore(checkedProduct(readSize(), 2));
+        if (!lazyCode)
+          addPredecoded(index, Predecoded::pkCodeBlock, sizeField);
+        ignore(4 + 4);
+        ignore(readSize());
+        ignore(4);
+        skipRefs();
+        break;
+      }
+      case 13: case 17: ignore(4); break;
+      case 14: skipRefs(); break;
+      case 16: ignore(UUID::byte_count + 4); skipRefs(); break;
+      case 19: ignore(UUID::byte_count); break;
+      case 20: ignore(UUID::byte_count); ignore(readSize()); break;
+      case 22: ignore(checkedProduct(readSize() / 2, 4 + 4)); break;
+      default: raiseCorrupted();
+    }
+  }
+
+  void addPredecoded(size_t index, Predecoded::Kind kind,
+                     const unsigned char* sizeField) {
+    // A node defined twice
+    if (!predecoded->add(index, kind, sizeField))
+      raiseCorrupted();
+  }
+
+  /** Has the value of the current node been predecoded as `kind`? */
+  bool isPredecoded(Predecoded::Kind kind) {
+    return predecoded != nullptr && predecoded->has(currentIndex, kind);
+  }
+
   UnstableNode readIntValue() {
-    std::string str = readString();
-    char* end = nullptr;
-    errno = 0; // reset errno since we need to know if strtoll() overflowed
-    nativeint value = internal::strto<nativeint>(str.c_str(), &end, 10);
-    assert(*end == '\0' && "bad integer string");
-    if ((value == SmallInt::min() || value == SmallInt::max()) &&
-        errno == ERANGE) { // Overflow
-      return BigInt::build(vm, str);
+    size_t length = readSize();
+    const unsigned char* str = read(length);
+
+    nativeint value;
+    bool fits;
+    if (isPredecoded(Predecoded::pkInt)) {
+      value = predecoded->intValue(currentIndex);
+      fits = true;
     } else {
-      return SmallInt::build(vm, value);
+      fits = decodeInt(str, length, value);
     }
+
+    if (fits)
+      return SmallInt::build(vm, value);
+    else
+      return BigInt::build(
+        vm, std::string(reinterpret_cast<const char*>(str), length));
   }
 
   UnstableNode readFloatValue() {
-    std::string str = readString();
-    char* end = nullptr;
-    double doubleResult = std::strtod(str.c_str(), &end);
-    assert(*end == '\0' && "bad float string");
-    return build(vm, doubleResult);
+    size_t length = readSize();
+    const unsigned char* str = read(length);
+
+    if (isPredecoded(Predecoded::pkFloat))
+      return build(vm, predecoded->floatValue(currentIndex));
+    else
+      return build(vm, decodeFloat(str, length));
   }
 
   UnstableNode readBooleanValue() {
@@ -188,19 +499,23 @@ private:
   }
 
   UnstableNode readCodeAreaValue() {
+    std::vector<ByteCode>* decoded = nullptr;
+    if (isPredecoded(Predecoded::pkCodeBlock))
+      decoded = &predecoded->codeBlock(currentIndex);
+
     return readGlobalEntity(
-      [this] (const UUID& uuid, GlobalNode* gnode) -> UnstableNode {
+      [this, decoded] (const UUID& uuid, GlobalNode* gnode) -> UnstableNode {
         size_t size = readSize();
-        std::vector<unsigned char> buffer;
-        buffer.resize(size*2);
-        read(reinterpret_cast<char*>(buffer.data()), size*2);
+        const unsigned char* buffer = read(checkedProduct(size, 2));
+
+        if (lazyCode)
+          return readLazyCodeArea(uuid, buffer, size);
 
         std::vector<ByteCode> codeBlock;
-        codeBlock.resize(size);
-        for (size_t i = 0; i < size; ++i) {
-          codeBlock[i] =
-            ((ByteCode) buffer[i*2] << 8) | (ByteCode) buffer[i*2+1];
-        }
+        if (decoded != nullptr)
+          codeBlock.swap(*decoded);
+        else
+          decodeCodeBlock(buffer, size, codeBlock);
 
         size_t arity = readSize();
         size_t Xcount = readSize();
@@ -219,15 +534,45 @@ private:
       },
       [this] () {
         size_t size = readSize();
-        ignore(size*2 + (4 + 4));
+        ignore(checkedProduct(size, 2));
+        ignore(4 + 4);
         readString();
         readSize();
         size_t Kcount = readSize();
-        ignore(Kcount*4);
+        ignore(checkedProduct(Kcount, 4));
       }
     );
   }
 
+  /**
+   * Code area whose byte-code is decoded when first used
+   * Only its range of the input is kept until then, so that the input can be
+   * freed once unpickled.
+   */
+  UnstableNode readLazyCodeArea(const UUID& uuid,
+                                const unsigned char* buffer, size_t size) {
+    size_t arity = readSize();
+    size_t Xcount = readSize();
+    atom_t printName = readAtom();
+    auto debugData = readNode();
+    size_t Kcount = readSize();
+
+    // Scoped, since a raise in readNodes() would skip its destructor
+    UnstableNode result;
+    {
+      auto pickledCodeBlock = std::make_shared<std::vector<unsigned char>>(
+        buffer, buffer + size*2);
+      result = CodeArea::build(
+        vm, Kcount, uuid, pickledCodeBlock->data(), pickledCodeBlock, size*2,
+        arity, Xcount, printName, debugData);
+    }
+
+    readNodes(RichNode(result).as<CodeArea>().getElementsArray(), Kcount);
+    RichNode(result).as<CodeArea>().setUUID(vm, uuid);
+
+    return result;
+  }
+
   UnstableNode readPatMatWildcardValue() {
     return PatMatCapture::build(vm, -1);
   }
@@ -264,7 +609,7 @@ private:
       [this] () {
         ignore(4);
         size_t Gcount = readSize();
-        ignore(Gcount*4);
+        ignore(checkedProduct(Gcount, 4));
       }
     );
   }
@@ -308,7 +653,33 @@ private:
   }
 
   UnstableNode readUnicodeStringValue() {
-    return String::build(vm, newLString(vm, readString()));
+    size_t length = readSize();
+    auto str = reinterpret_cast<const char*>(read(length));
+    return String::build(vm, newLString(vm, str, length));
+  }
+
+  UnstableNode readPersistentMapValue() {
+    // Keys are features, hence they were already read and bound
+    size_t count = readSize() / 2;
+    UnstableNode result = PersistentMap::build(vm);
+    for (size_t i = 0; i < count; ++i) {
+      auto key = readNode();
+      auto value = readNode();
+      result = RichNode(result).as<PersistentMap>().put(vm, key, value);
+    }
+    return result;
+  }
+
+  UnstableNode readByteStringValue() {
+    size_t length = readSize();
+    const unsigned char* bytes = read(length);
+
+    if ((storage != nullptr) && (length >= externalByteStringThreshold)) {
+      return ByteString::build(
+        vm, LString<unsigned char>::fromExternal(bytes, length), storage);
+    }
+
+    return ByteString::build(vm, newLString(vm, bytes, length));
   }
 
   template <typename F, typename G>
@@ -327,37 +698,31 @@ private:
 private:
   /** Read a size integer */
   size_t readSize() {
-    unsigned char bytes[4];
-    read(reinterpret_cast<char*>(bytes), 4);
-    return ((size_t) bytes[0] << 24) | ((size_t) bytes[1] << 16) |
-      ((size_t) bytes[2] << 8) | (size_t) bytes[3];
+    return decodeSize(read(4));
   }
 
   /** Read a byte */
   unsigned char readByte() {
-    char bytes[1];
-    read(bytes, 1);
-    return (unsigned char) bytes[0];
+    return *read(1);
   }
 
   /** Read a string */
   std::string readString() {
     size_t length = readSize();
-    std::string result(length, '\0');
-    read(&result[0], length);
-    return result;
+    return std::string(reinterpret_cast<const char*>(read(length)), length);
   }
 
   /** Read an atom */
   atom_t readAtom() {
-    std::string str = readString();
-    return vm->getAtom(str.size(), str.data());
+    size_t length = readSize();
+    return vm->getAtom(length, reinterpret_cast<const char*>(read(length)));
   }
 
   /** Read a node reference */
   template <typename T>
   void readNode(T& dest) {
     size_t index = readSize();
+    checkIndex(index);
     dest.init(vm, nodes[index]);
   }
 
@@ -375,33 +740,76 @@ private:
       readNode(elements[i]);
   }
 
+  /** Skip a counted array of node references */
+  void skipRefs() {
+    size_t count = readSize();
+    ignore(checkedProduct(count, 4));
+  }
+
   /** Read a UUID */
   UUID readUUID() {
-    char buffer[UUID::byte_count];
-    read(buffer, UUID::byte_count);
-    return UUID(reinterpret_cast<unsigned char*>(buffer));
+    return UUID(read(UUID::byte_count));
   }
 
-  /** Read a byte array */
-  void read(char* buffer, size_t length) {
-    input.read(buffer, length);
-    assert(!input.bad() && "failure while reading");
-    assert(!input.eof() && "reached eof too early");
+  /**
+   * Consume the `length` following bytes of the input
+   * @return A pointer to these bytes, valid as long as the input is if it is
+   *         in memory, or until the next read from a source
+   */
+  const unsigned char* read(size_t length) {
+    if ((length > available()) &&
+        ((source == nullptr) || !source->refill(current, end, length)))
+      raiseCorrupted();
+    const unsigned char* result = current;
+    current += length;
+    return result;
   }
 
   /** Ignore the `count` following bytes of the input */
   void ignore(size_t count) {
-    /* We cannot use input.ignore() here because of a bug in the implementation
-     * of that function in libc++. */
-    std::vector<char> dummy;
-    dummy.resize(count);
-    read(dummy.data(), count);
+    read(count);
+  }
+
+  /** Number of bytes of the input that can be read without a refill */
+  size_t available() {
+    return end - current;
+  }
+
+  /** Upper bound of the number of bytes left in the input */
+  size_t remaining() {
+    if (source == nullptr)
+      return available();
+    return available() + source->maxRemaining();
+  }
+
+  /** Compute `count * factor`, where `count` was read from the input */
+  size_t checkedProduct(size_t count, size_t factor) {
+    if (count > remaining() / factor)
+      raiseCorrupted();
+    return count * factor;
+  }
+
+  void checkIndex(size_t index) {
+    if (index >= nodes.size())
+      raiseCorrupted();
+  }
+
+  void MOZART_NORETURN raiseCorrupted() {
+    raiseCorruptedPickle(vm);
   }
 
 private:
   VM vm;
-  std::istream& input;
+  const unsigned char* current;
+  const unsigned char* end;
+  UnpickleSource* const source;
+  const bool lazyCode;
+  const bool parallel;
+  std::shared_ptr<const void> storage; // owner of the input, if shared
   std::vector<UnstableNode> nodes;
+
+  std::unique_ptr<Predecoded> predecoded;
+  size_t currentIndex;
 };
 
 } // namespace <anonymous>
@@ -410,9 +818,208 @@ private:
 // Entry point //
 /////////////////
 
-UnstableNode unpickle(VM vm, std::istream& input) {
-  Unpickler unpickler(vm, input);
+#ifdef USE_ZLIB
+
+namespace {
+
+/**
+ * Size of the pieces in which zlib is fed and drained
+ * zlib counts its buffers in uInt, so larger inputs and outputs must be
+ * processed in several steps.
+ */
+const size_t inflateChunkSize = 1024 * 1024;
+
+/** Size of the window of inflated input, unless a value needs more */
+const size_t inflateWindowSize = 64 * 1024;
+
+/** Largest expansion of deflated data, plus what zlib may still hold */
+const size_t maxInflateRatio = 1032;
+const size_t maxInflatePending = 64 * 1024;
+
+/** Source that inflates a zlib stream in memory as it is read */
+class Inflater: public UnpickleSource {
+public:
+  Inflater(const unsigned char* data, size_t size):
+    input(data), inputEnd(data + size), started(false), ended(false) {}
+
+  bool init() {
+    stream.zalloc = Z_NULL;
+    stream.zfree = Z_NULL;
+    stream.opaque = Z_NULL;
+    stream.next_in = Z_NULL;
+    stream.avail_in = 0;
+    started = (inflateInit(&stream) == Z_OK);
+    return started;
+  }
+
+  bool refill(const unsigned char*& current, const unsigned char*& end,
+              size_t length) {
+    // Move what is left to the start of a window that can hold length bytes
+    size_t kept = end - current;
+    if (window.size() < std::max(length, inflateWindowSize)) {
+      std::vector<unsigned char> larger(
+        std::max({ length, inflateWindowSize, 2 * window.size() }));
+      std::copy(current, end, larger.data());
+      window.swap(larger);
+    } else if (kept > 0) {
+      std::memmove(window.data(), current, kept);
+    }
+
+    size_t filled = kept;
+    while ((filled < length) && !ended) {
+      if (stream.avail_in == 0) {
+        size_t chunk = std::min((size_t) (inputEnd - input), inflateChunkSize);
+        stream.next_in = const_cast<Bytef*>(input);
+        stream.avail_in = (uInt) chunk;
+        input += chunk;
+      }
+
+      size_t room = std::min(window.size() - filled, inflateChunkSize);
+      stream.next_out = window.data() + filled;
+      stream.avail_out = (uInt) room;
+
+      // Z_BUF_ERROR means that all the input was consumed too early
+      int status = inflate(&stream, Z_NO_FLUSH);
+      filled += room - stream.avail_out;
+      if (status == Z_STREAM_END)
+        ended = true;
+      else if (status != Z_OK)
+        break;
+    }
+
+    current = window.data();
+    end = window.data() + filled;
+    return filled >= length;
+  }
+
+  size_t maxRemaining() {
+    if (ended)
+      return 0;
+    size_t compressed = (inputEnd - input) + stream.avail_in;
+    size_t bound = (std::numeric_limits<size_t>::max() - maxInflatePending) /
+      maxInflateRatio;
+    return std::min(compressed, bound) * maxInflateRatio + maxInflatePending;
+  }
+
+  /** Inflate the rest of the stream, return false if it is corrupted */
+  bool finish() {
+    while (!ended) {
+      const unsigned char* current = nullptr;
+      const unsigned char* end = nullptr;
+      if (!refill(current, end, inflateWindowSize) && !ended)
+        return false;
+    }
+    return true;
+  }
+
+  /** Free the zlib state and the window */
+  void release() {
+    if (started)
+      inflateEnd(&stream);
+    started = false;
+    std::vector<unsigned char>().swap(window);
+  }
+
+private:
+  const unsigned char* input;
+  const unsigned char* const inputEnd;
+  bool started;
+  bool ended;
+  z_stream stream;
+  std::vector<unsigned char> window;
+};
+
+/**
+ * Unpickle a zlib stream as it is inflated
+ * Only a window of the inflated pickle is in memory at once.
+ */
+UnstableNode unpickleCompressed(VM vm, const unsigned char* data,
+                                size_t size) {
+  Inflater inflater(data, size);
+  if (!inflater.init())
+    raiseError(vm, "Could not initialize zlib decompression");
+
+  UnstableNode result;
+  MOZART_TRY(vm) {
+    Unpickler unpickler(vm, inflater);
+    result = unpickler.unpickle();
+  } MOZART_CATCH(vm, kind, node) {
+    // The raise skips the destructor of inflater
+    inflater.release();
+    MOZART_RETHROW(vm);
+  } MOZART_ENDTRY(vm);
+
+  bool complete = inflater.finish();
+  inflater.release();
+  if (!complete)
+    raiseCorruptedPickle(vm);
+
+  return result;
+}
+
+} // namespace <anonymous>
+
+#endif // USE_ZLIB
+
+namespace {
+
+UnstableNode unpickleFromMemory(VM vm, const unsigned char* data, size_t size,
+                                bool parallel) {
+  if (isCompressedPickle(data, size)) {
+    unsigned char method = data[compressedPickleHeaderSize - 1];
+#ifdef USE_ZLIB
+    if (method == zlibPickleMethod) {
+      return unpickleCompressed(vm, data + compressedPickleHeaderSize,
+                                size - compressedPickleHeaderSize);
+    }
+#endif
+    raiseError(vm, "dp", "generic", "unpickle:compression",
+               "This compression method is not supported by this build",
+               build(vm, (nativeint) method));
+  }
+
+  Unpickler unpickler(vm, data, size, false, parallel);
   return unpickler.unpickle();
 }
 
+} // namespace <anonymous>
+
+UnstableNode unpickle(VM vm, const unsigned char* data, size_t size) {
+  return unpickleFromMemory(vm, data, size, false);
+}
+
+UnstableNode unpickleFile(VM vm, const unsigned char* data, size_t size) {
+  bool parallel = vm->getPropertyRegistry().config.parallelUnpickle;
+  return unpickleFromMemory(vm, data, size, parallel);
+}
+
+UnstableNode unpickleLazily(VM vm, const unsigned char* data, size_t size) {
+  // Decompressed data would not outlive this call
+  if (isCompressedPickle(data, size))
+    return unpickleFile(vm, data, size);
+
+  bool parallel = vm->getPropertyRegistry().config.parallelUnpickle;
+  Unpickler unpickler(vm, data, size, true, parallel);
+  return unpickler.unpickle();
+}
+
+UnstableNode unpickleShared(VM vm,
+                            const std::shared_ptr<const std::string>& buffer) {
+  auto data = reinterpret_cast<const unsigned char*>(buffer->data());
+  size_t size = buffer->size();
+
+  // Decompressed data is not shared
+  if (isCompressedPickle(data, size))
+    return unpickle(vm, data, size);
+
+  Unpickler unpickler(vm, data, size, false, false, buffer);
+  return unpickler.unpickle();
+}
+
+UnstableNode unpickle(VM vm, std::istream& input) {
+  std::vector<unsigned char> buffer{std::istreambuf_iterator<char>(input),
+                                    std::istreambuf_iterator<char>()};
+  return unpickle(vm, buffer.data(), buffer.size());
+}
+
 } // namespace mozart
@@ -28,9 +28,45 @@
 #include "mozartcore.hh"
 
 #include <istream>
+#include <memory>
+#include <string>
 
 namespace mozart {
 
+/**
+ * Unpickle a value from a contiguous memory range
+ * The range must stay valid until this function returns, but not longer.
+ */
+UnstableNode unpickle(VM vm, const unsigned char* data, size_t size);
+
+/**
+ * Unpickle a value from the contents of a file
+ * When the property pickle.parallel is true, the numbers and byte-code of
+ * large files are decoded on several threads first, if the environment
+ * provides them. Small pickles, such as messages, are not worth it, and
+ * compressed ones are inflated as they are read instead.
+ */
+UnstableNode unpickleFile(VM vm, const unsigned char* data, size_t size);
+
+/**
+ * Unpickle a value from a contiguous memory range, such as a boot file
+ * The byte-code of the procedures is decoded only when they are first
+ * called, so that unused procedures are never decoded. Until then, each code
+ * area keeps a copy of its own byte-code range, so that the range given
+ * here must stay valid until this function returns, but not longer. Numbers
+ * are decoded as by unpickleFile().
+ */
+UnstableNode unpickleLazily(VM vm, const unsigned char* data, size_t size);
+
+/**
+ * Unpickle a value from a buffer that the result may keep
+ * Large byte strings point into the buffer instead of being copied, and keep
+ * it alive as long as they live. Meant for messages, whose buffer is not
+ * used for anything else once unpickled.
+ */
+UnstableNode unpickleShared(VM vm,
+                            const std::shared_ptr<const std::string>& buffer);
+
 UnstableNode unpickle(VM vm, std::istream& input);
 
 }
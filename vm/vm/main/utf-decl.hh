@@ -29,6 +29,7 @@
 
 #include "core-forward-decl.hh"
 #include "lstring-decl.hh"
+#include "cpufeatures-decl.hh"
 
 namespace mozart {
 
@@ -181,6 +182,40 @@ template <class C>
 inline LString<C> sliceByCodePointsFrom(const LString<C>& input,
                                         nativeint from);
 
+///////////////////////////
+// Bulk UTF-8 processing //
+///////////////////////////
+
+/**
+ * Check that a UTF-8 string is well-formed. Runs of ASCII characters are
+ * skipped with the vectorized kernels, so this is much faster than
+ * forEachCodePoint() on mostly-ASCII input.
+ *
+ * @return
+ *      UnicodeErrorReason::empty if the string is valid, otherwise the reason
+ *      of the first error found (the same as reported by fromUTF()).
+ */
+inline UnicodeErrorReason validateUTF8(const char* utf, nativeint length);
+
+namespace internal {
+  /**
+   * Number of leading bytes of utf which are ASCII (< 0x80).
+   */
+  nativeint asciiPrefixLength(const char* utf, nativeint length,
+                              SIMDLevel level);
+  inline nativeint asciiPrefixLength(const char* utf, nativeint length);
+
+  /**
+   * Zero-extend length ASCII characters to UTF-16 or UTF-32 code units.
+   */
+  void widenASCII(const char* utf, nativeint length, char16_t* dest,
+                  SIMDLevel level);
+  void widenASCII(const char* utf, nativeint length, char32_t* dest,
+                  SIMDLevel level);
+  inline void widenASCII(const char* utf, nativeint length, char16_t* dest);
+  inline void widenASCII(const char* utf, nativeint length, char32_t* dest);
+}
+
 }
 
 #endif // MOZART_UTF_DECL_H
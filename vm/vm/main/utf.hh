@@ -274,8 +274,54 @@ void forEachCodePoint(const BaseLString<C>& string,
   }
 }
 
+///////////////////////////
+// Bulk UTF-8 processing //
+///////////////////////////
+
+namespace internal {
+  inline
+  nativeint asciiPrefixLength(const char* utf, nativeint length) {
+    static const SIMDLevel level = detectSIMDLevel();
+    return asciiPrefixLength(utf, length, level);
+  }
+
+  inline
+  void widenASCII(const char* utf, nativeint length, char16_t* dest) {
+    static const SIMDLevel level = detectSIMDLevel();
+    widenASCII(utf, length, dest, level);
+  }
+
+  inline
+  void widenASCII(const char* utf, nativeint length, char32_t* dest) {
+    static const SIMDLevel level = detectSIMDLevel();
+    widenASCII(utf, length, dest, level);
+  }
+}
+
+UnicodeErrorReason validateUTF8(const char* utf, nativeint length) {
+  const char* cur = utf;
+  const char* end = utf + length;
+  while (cur < end) {
+    cur += internal::asciiPrefixLength(cur, end - cur);
+
+    while (cur < end && (unsigned char) *cur >= 0x80) {
+      auto codePointSizePair = fromUTF(cur, end - cur);
+      if (codePointSizePair.second < 0)
+        return (UnicodeErrorReason) codePointSizePair.second;
+      cur += codePointSizePair.second;
+    }
+  }
+  return UnicodeErrorReason::empty;
+}
+
+/////////////////////////////////
+// Unicode encoding conversion //
+/////////////////////////////////
+
+// The generic convertor, which works one code point at a time. It is also the
+// reference implementation against which the bulk convertors are tested.
 template <class To, class From>
-struct UTFConvertor {
+struct ScalarUTFConvertor {
   static ContainedLString<std::vector<To>> call(const BaseLString<From>& input) {
     // propagate error if needed.
     if (input.isErrorOrEmpty())
@@ -312,7 +358,7 @@ struct UTFConvertor {
 };
 
 template <class To>
-struct UTFConvertor<To, To> {
+struct ScalarUTFConvertor<To, To> {
   static ContainedLString<std::vector<To>> call(const BaseLString<To>& input) {
     // propagate error if needed.
     if (input.isErrorOrEmpty())
@@ -335,6 +381,63 @@ struct UTFConvertor<To, To> {
   }
 };
 
+template <class To, class From>
+struct UTFConvertor: ScalarUTFConvertor<To, From> {};
+
+// Decoding UTF-8 is the hot path (every ByteString decoded by Coders goes
+// through it), so it has dedicated convertors which copy ASCII runs in bulk.
+template <class To>
+struct BulkUTF8Convertor {
+  static ContainedLString<std::vector<To>> call(const BaseLString<char>& input) {
+    if (input.isErrorOrEmpty())
+      return input.error;
+
+    // A UTF-8 sequence never needs more code units in UTF-16 or UTF-32.
+    std::vector<To> result(input.length);
+    To* out = result.data();
+
+    const char* cur = input.begin();
+    const char* end = input.end();
+    while (cur < end) {
+      nativeint asciiLength = internal::asciiPrefixLength(cur, end - cur);
+      internal::widenASCII(cur, asciiLength, out);
+      cur += asciiLength;
+      out += asciiLength;
+
+      while (cur < end && (unsigned char) *cur >= 0x80) {
+        auto codePointSizePair = fromUTF(cur, end - cur);
+        if (codePointSizePair.second < 0)
+          return (UnicodeErrorReason) codePointSizePair.second;
+        out += toUTF(codePointSizePair.first, out); // always valid here
+        cur += codePointSizePair.second;
+      }
+    }
+
+    result.resize(out - result.data());
+    return std::move(result);
+  }
+};
+
+template <>
+struct UTFConvertor<char16_t, char>: BulkUTF8Convertor<char16_t> {};
+
+template <>
+struct UTFConvertor<char32_t, char>: BulkUTF8Convertor<char32_t> {};
+
+template <>
+struct UTFConvertor<char, char> {
+  static ContainedLString<std::vector<char>> call(const BaseLString<char>& input) {
+    if (input.isErrorOrEmpty())
+      return input.error;
+
+    UnicodeErrorReason error = validateUTF8(input.string, input.length);
+    if (error != UnicodeErrorReason::empty)
+      return error;
+    else
+      return ContainedLString<std::vector<char>>(input.begin(), input.end());
+  }
+};
+
 template <class To, class From>
 ContainedLString<std::vector<To>> toUTF(const BaseLString<From>& input) {
   return UTFConvertor<To, From>::call(input);
@@ -0,0 +1,126 @@
+// Copyright © 2014, Université catholique de Louvain
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// *  Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// *  Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MOZART_VECTOR_DECL_H
+#define MOZART_VECTOR_DECL_H
+
+#include "mozartcore-decl.hh"
+
+namespace mozart {
+
+////////////
+// Vector //
+////////////
+
+#ifndef MOZART_GENERATOR
+#include "Vector-implem-decl.hh"
+#endif
+
+/**
+ * Growable array of values, indexed from 1
+ * push and pop work at the end in amortized constant time. The elements live
+ * in a buffer allocated in the VM heap, which is doubled when it is full;
+ * buffers left behind by a growth are reclaimed by the next GC, which also
+ * shrinks the capacity to the actual size.
+ */
+class Vector: public DataType<Vector>, public WithHome {
+public:
+  static atom_t getTypeAtom(VM vm) {
+    return vm->getAtom("vector");
+  }
+
+  inline
+  Vector(VM vm, size_t initialCapacity);
+
+  inline
+  Vector(VM vm, GR gr, Vector& from);
+
+public:
+  size_t getSize() {
+    return _size;
+  }
+
+  size_t getCapacity() {
+    return _capacity;
+  }
+
+public:
+  // Operations
+
+  inline
+  UnstableNode size(VM vm);
+
+  inline
+  UnstableNode get(RichNode self, VM vm, RichNode index);
+
+  inline
+  void put(RichNode self, VM vm, RichNode index, RichNode value);
+
+  inline
+  void push(VM vm, RichNode value);
+
+  inline
+  UnstableNode pop(RichNode self, VM vm);
+
+  inline
+  UnstableNode toTuple(VM vm, RichNode label);
+
+  inline
+  UnstableNode toList(VM vm);
+
+public:
+  // Miscellaneous
+
+  void printReprToStream(VM vm, std::ostream& out, int depth, int width) {
+    out << "<Vector " << _size << ">";
+  }
+
+private:
+  inline
+  size_t getOffset(RichNode self, VM vm, RichNode index);
+
+  inline
+  void reserve(VM vm, size_t capacity);
+
+  static UnstableNode* allocElements(VM vm, size_t capacity) {
+    if (capacity == 0)
+      return nullptr;
+
+    return new (vm) UnstableNode[capacity];
+  }
+
+  static constexpr size_t minGrowCapacity = 4;
+
+  UnstableNode* _elements;
+  size_t _size;
+  size_t _capacity;
+};
+
+#ifndef MOZART_GENERATOR
+#include "Vector-implem-decl-after.hh"
+#endif
+
+}
+
+#endif // MOZART_VECTOR_DECL_H
@@ -0,0 +1,125 @@
+// Copyright © 2014, Université catholique de Louvain
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// *  Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// *  Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MOZART_VECTOR_H
+#define MOZART_VECTOR_H
+
+#include "mozartcore.hh"
+
+#ifndef MOZART_GENERATOR
+
+namespace mozart {
+
+////////////
+// Vector //
+////////////
+
+#include "Vector-implem.hh"
+
+Vector::Vector(VM vm, size_t initialCapacity): WithHome(vm) {
+  _elements = allocElements(vm, initialCapacity);
+  _size = 0;
+  _capacity = initialCapacity;
+}
+
+Vector::Vector(VM vm, GR gr, Vector& from): WithHome(vm, gr, from) {
+  // Drop the unused capacity, the next push will grow it again
+  _size = from._size;
+  _capacity = _size;
+  _elements = allocElements(vm, _capacity);
+
+  for (size_t i = 0; i < _size; i++)
+    gr->copyUnstableNode(_elements[i], from._elements[i]);
+}
+
+UnstableNode Vector::size(VM vm) {
+  return mozart::build(vm, _size);
+}
+
+UnstableNode Vector::get(RichNode self, VM vm, RichNode index) {
+  return { vm, _elements[getOffset(self, vm, index)] };
+}
+
+void Vector::put(RichNode self, VM vm, RichNode index, RichNode value) {
+  if (!isHomedInCurrentSpace(vm))
+    raise(vm, "globalState", "vector");
+
+  _elements[getOffset(self, vm, index)].copy(vm, value);
+}
+
+void Vector::push(VM vm, RichNode value) {
+  if (!isHomedInCurrentSpace(vm))
+    raise(vm, "globalState", "vector");
+
+  if (_size == _capacity)
+    reserve(vm, std::max(2 * _capacity, minGrowCapacity));
+
+  _elements[_size].init(vm, value);
+  _size++;
+}
+
+UnstableNode Vector::pop(RichNode self, VM vm) {
+  if (!isHomedInCurrentSpace(vm))
+    raise(vm, "globalState", "vector");
+
+  if (_size == 0)
+    raise(vm, "emptyVector", self);
+
+  _size--;
+  return std::move(_elements[_size]);
+}
+
+UnstableNode Vector::toTuple(VM vm, RichNode label) {
+  return buildTupleDynamic(vm, label, _size, _elements);
+}
+
+UnstableNode Vector::toList(VM vm) {
+  return buildListDynamic(vm, _size, _elements);
+}
+
+size_t Vector::getOffset(RichNode self, VM vm, RichNode index) {
+  auto indexIntValue = getArgument<nativeint>(vm, index, "integer");
+
+  if ((indexIntValue < 1) || ((size_t) indexIntValue > _size))
+    raise(vm, "vectorIndexOutOfBounds", self, index);
+
+  return (size_t) indexIntValue - 1;
+}
+
+void Vector::reserve(VM vm, size_t capacity) {
+  assert(capacity >= _size);
+
+  UnstableNode* newElements = allocElements(vm, capacity);
+  for (size_t i = 0; i < _size; i++)
+    new (&newElements[i]) UnstableNode(std::move(_elements[i]));
+
+  _elements = newElements;
+  _capacity = capacity;
+}
+
+}
+
+#endif // MOZART_GENERATOR
+
+#endif // MOZART_VECTOR_H
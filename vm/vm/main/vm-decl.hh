@@ -32,6 +32,7 @@
 #include "core-forward-decl.hh"
 
 #include "memmanager.hh"
+#include "opcodes.hh"
 
 #include "store-decl.hh"
 #include "threadpool-decl.hh"
@@ -44,7 +45,12 @@
 #include "atomtable.hh"
 #include "bigintimplem-decl.hh"
 #include "coreatoms-decl.hh"
+#include "opcodestats-decl.hh"
 #include "properties-decl.hh"
+#include "profiler-decl.hh"
+#include "tracer-decl.hh"
+#include "perfmap-decl.hh"
+#include "builtinstats-decl.hh"
 
 namespace mozart {
 
@@ -131,6 +137,32 @@ public:
   inline
   virtual void sendOnVMPort(VM from, VMIdentifier to, RichNode value);
 
+  /**
+   * Byte-code of a code area unpickled lazily, to be shared by all the VMs
+   * of the process. The block lives as long as a code area holds it.
+   * Returns nullptr if this environment does not share code, in which case
+   * the code area gets its own copy in the heap of its VM.
+   */
+  virtual std::shared_ptr<const std::vector<ByteCode>> getSharedCodeBlock(
+    const UUID& uuid, const ByteCode* codeBlock, size_t size) {
+    return nullptr;
+  }
+
+  /** Number of threads parallelFor() may use at once */
+  virtual size_t getParallelism() {
+    return 1;
+  }
+
+  /**
+   * Call body(from, to) on ranges covering [0, count), possibly on several
+   * threads at once, and return when all of them are done.
+   * body must not use any VM.
+   */
+  virtual void parallelFor(size_t count,
+                           const std::function<void(size_t, size_t)>& body) {
+    body(0, count);
+  }
+
   virtual void gCollect(GC gc) {
   }
 
@@ -269,6 +301,42 @@ public:
     return _propertyRegistry;
   }
 
+  Profiler& getProfiler() {
+    return _profiler;
+  }
+
+  AllocationProfiler& getAllocationProfiler() {
+    return _allocationProfiler;
+  }
+
+  Tracer& getTracer() {
+    return _tracer;
+  }
+
+  PerfMap& getPerfMap() {
+    return _perfMap;
+  }
+
+  BuiltinStats& getBuiltinStats() {
+    return _builtinStats;
+  }
+
+  std::uint64_t newThreadId() {
+    return ++_lastThreadId;
+  }
+
+  OpcodeStats& getOpcodeStats() {
+    return _opcodeStats;
+  }
+
+  GCStatistics& getGCStatistics() {
+    return _gcStatistics;
+  }
+
+  HeapCensus& getHeapCensus() {
+    return _heapCensus;
+  }
+
   inline
   UUID genUUID();
 
@@ -411,6 +479,14 @@ private:
 
   NodeDictionary* _builtinModules;
   PropertyRegistry _propertyRegistry;
+  Profiler _profiler;
+  AllocationProfiler _allocationProfiler;
+  OpcodeStats _opcodeStats;
+  GCStatistics _gcStatistics;
+  HeapCensus _heapCensus;
+  Tracer _tracer;
+  PerfMap _perfMap;
+  BuiltinStats _builtinStats;
 
   RunnableList aliveThreads;
   VMCleanupListNode* _cleanupList;
@@ -430,6 +506,8 @@ private:
   std::atomic_flag _gcRequestedNot;
   std::atomic<std::int64_t> _referenceTime;
 
+  std::uint64_t _lastThreadId;
+
   // During GC, we need a SpaceRef version of the top-level space
   SpaceRef _topLevelSpaceRef;
 };
@@ -44,6 +44,9 @@ VirtualMachine::run_return_type VirtualMachine::run() {
     while (!_alarms.empty() && (_alarms.front().expiration <= now)) {
       getTopLevelSpace()->install();
 
+      if (_tracer.isEnabled())
+        _tracer.traceAlarm();
+
       Wakeable(*_alarms.front().wakeable).wakeUp(this);
 
       _alarms.remove_front(this);
@@ -69,7 +72,10 @@ VirtualMachine::run_return_type VirtualMachine::run() {
     // Run the thread
     assert(currentThread->isRunnable());
     _currentThread = currentThread;
+    std::int64_t quantumStartTime = _tracer.isEnabled() ? _tracer.now() : -1;
     currentThread->run();
+    if (_tracer.isEnabled() && quantumStartTime >= 0)
+      _tracer.traceRun(currentThread->getId(), quantumStartTime);
     _currentThread = nullptr;
 
     // Schedule the thread anew if it is still runnable
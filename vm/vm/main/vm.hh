@@ -27,6 +27,8 @@
 
 #include "mozartcore.hh"
 
+#include <chrono>
+
 #ifndef MOZART_GENERATOR
 
 namespace mozart {
@@ -77,7 +79,7 @@ VirtualMachine::VirtualMachine(VirtualMachineEnvironment& environment,
   _preemptRequestedNot(ATOMIC_FLAG_INIT),
   _exitRunRequestedNot(ATOMIC_FLAG_INIT),
   _gcRequestedNot(ATOMIC_FLAG_INIT),
-  _referenceTime(0) {
+  _referenceTime(0), _lastThreadId(0) {
 
   memoryManager.init(this);
 
@@ -182,6 +184,21 @@ void VirtualMachine::initialize() {
 }
 
 void VirtualMachine::doGC() {
+  using namespace std::chrono;
+
+  auto startTime = steady_clock::now();
+  std::int64_t traceStartTime = _tracer.isEnabled() ? _tracer.now() : -1;
+  GCEvent event;
+  event.number = _gcStatistics.getCount() + 1;
+  event.time = getReferenceTime();
+  event.bytesBefore = memoryManager.getAllocated();
+
+  // Allocation samples refer to procedures that are about to move
+  _allocationProfiler.resolve(this);
+
+  // Code blocks are about to move
+  _perfMap.beforeGC();
+
   // Update stats (1)
   getPropertyRegistry().stats.totalUsedMemory +=
     memoryManager.getAllocatedOutsideFreeList();
@@ -193,6 +210,18 @@ void VirtualMachine::doGC() {
     secondMemoryManager.releaseExtraAllocs();
   });
 
+  // Record the GC event
+  event.pause = duration_cast<microseconds>(
+    steady_clock::now() - startTime).count();
+  event.bytesCopied = memoryManager.getAllocated();
+  if (event.bytesBefore > event.bytesCopied)
+    event.bytesFreed = event.bytesBefore - event.bytesCopied;
+  gc.getLiveCounts(event);
+  _gcStatistics.record(event);
+
+  if (_tracer.isEnabled() && traceStartTime >= 0)
+    _tracer.traceGC(traceStartTime);
+
   // Handle the GC watcher
   UnstableNode watcher;
   if (getPropertyRegistry().get(this, "gc.watcher", watcher)) {
@@ -206,6 +235,14 @@ void VirtualMachine::doGC() {
                               /* forceWriteConstantProp = */ true);
   }
 
+  // Post the GC event to the stream of GC events
+  UnstableNode events;
+  if (getPropertyRegistry().get(this, "gc.events", events)) {
+    sendToReadOnlyStream(this, events, GCStatistics::buildEvent(this, event));
+    getPropertyRegistry().put(this, "gc.events", events,
+                              /* forceWriteConstantProp = */ true);
+  }
+
   // Update stats (2)
   size_t activeMemory = memoryManager.getAllocated();
   getPropertyRegistry().stats.activeMemory = activeMemory;
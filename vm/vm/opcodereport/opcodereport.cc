@@ -0,0 +1,113 @@
+// Copyright © 2014, Université catholique de Louvain
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// *  Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// *  Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Report of the opcode counters written by Profile.saveOpcodeCounts in a VM
+// built with MOZART_OPCODE_STATS.
+//
+// Usage: opcodereport <counts file> [<number of rows>]
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+typedef std::pair<std::string, std::uint64_t> Row;
+
+void printTable(const char* title, std::vector<Row>& rows, size_t maxRows) {
+  std::uint64_t total = 0;
+  for (auto& row : rows)
+    total += row.second;
+
+  std::stable_sort(rows.begin(), rows.end(),
+    [] (const Row& left, const Row& right) {
+      return left.second > right.second;
+    });
+
+  std::cout << title << " (" << rows.size() << " distinct, " << total
+            << " executed)\n";
+
+  std::uint64_t cumulated = 0;
+  for (size_t i = 0; i < rows.size() && i < maxRows; i++) {
+    cumulated += rows[i].second;
+    std::cout << std::setw(5) << (i+1) << "  "
+              << std::left << std::setw(32) << rows[i].first << std::right
+              << std::setw(14) << rows[i].second
+              << std::fixed << std::setprecision(2)
+              << std::setw(8) << (100.0 * rows[i].second / total) << "%"
+              << std::setw(8) << (100.0 * cumulated / total) << "%\n";
+  }
+
+  std::cout << "\n";
+}
+
+}
+
+int main(int argc, char** argv) {
+  if (argc < 2 || argc > 3) {
+    std::cerr << "Usage: " << argv[0]
+              << " <counts file> [<number of rows>]" << std::endl;
+    return 2;
+  }
+
+  std::ifstream input(argv[1]);
+  if (!input) {
+    std::cerr << argv[0] << ": cannot open " << argv[1] << std::endl;
+    return 1;
+  }
+
+  size_t maxRows = (argc == 3) ? std::strtoul(argv[2], nullptr, 10) : 30;
+
+  std::vector<Row> opcodes;
+  std::vector<Row> pairs;
+
+  std::string line;
+  while (std::getline(input, line)) {
+    std::istringstream fields(line);
+    std::string kind, first, second;
+    std::uint64_t count;
+
+    fields >> kind;
+    if (kind == "op" && (fields >> first >> count)) {
+      opcodes.emplace_back(first, count);
+    } else if (kind == "pair" && (fields >> first >> second >> count)) {
+      pairs.emplace_back(first + " -> " + second, count);
+    } else if (!kind.empty()) {
+      std::cerr << argv[0] << ": ignoring malformed line: " << line
+                << std::endl;
+    }
+  }
+
+  printTable("Opcodes", opcodes, maxRows);
+  printTable("Pairs of consecutive opcodes", pairs, maxRows);
+
+  return 0;
+}
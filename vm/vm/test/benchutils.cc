@@ -0,0 +1,78 @@
+#include "benchutils.hh"
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace {
+  class BenchEnvironment: public mozart::VirtualMachineEnvironment {
+  public:
+    BenchEnvironment(): parallelism(1), nextUUID(0) {}
+
+    // Deterministic, so that pickles do not change from run to run
+    mozart::UUID genUUID(mozart::VM vm) {
+      return mozart::UUID(1, ++nextUUID);
+    }
+
+    size_t getParallelism() {
+      return parallelism;
+    }
+
+    // One thread per range, so the timings include creating them
+    void parallelFor(size_t count,
+                     const std::function<void(size_t, size_t)>& body) {
+      size_t rangeSize = (count + parallelism - 1) / parallelism;
+      std::vector<std::thread> threads;
+      for (size_t from = rangeSize; from < count; from += rangeSize)
+        threads.emplace_back(body, from, std::min(from + rangeSize, count));
+      body(0, std::min(rangeSize, count));
+      for (auto& thread: threads)
+        thread.join();
+    }
+
+    size_t parallelism;
+  private:
+    std::uint64_t nextUUID;
+  };
+}
+
+namespace mozart {
+
+void MozartBench::SetUp(const ::benchmark::State& state) {
+  environment.reset(new BenchEnvironment());
+  virtualMachine.reset(new VirtualMachine(
+    *environment, { 64 * MegaBytes, 512 * MegaBytes }));
+  vm = virtualMachine.get();
+}
+
+void MozartBench::TearDown(const ::benchmark::State& state) {
+  virtualMachine.reset();
+  environment.reset();
+}
+
+void MozartBench::setParallelism(size_t threads) {
+  static_cast<BenchEnvironment&>(*environment).parallelism = threads;
+}
+
+void MozartBench::collect() {
+  vm->requestGC();
+  vm->run();
+}
+
+UnstableNode MozartBench::buildIntList(size_t length) {
+  UnstableNode result = buildNil(vm);
+  for (size_t i = length; i > 0; i--)
+    result = buildCons(vm, (nativeint) (i - 1), result);
+  return result;
+}
+
+UnstableNode MozartBench::buildRecordList(size_t length) {
+  UnstableNode result = buildNil(vm);
+  for (size_t i = length; i > 0; i--) {
+    result = buildCons(vm, buildRecord(
+      vm, buildArity(vm, "r", "a", "b", "c"), (nativeint) i, "x", 0.5 * i),
+      result);
+  }
+  return result;
+}
+
+}
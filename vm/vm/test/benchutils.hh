@@ -0,0 +1,56 @@
+#ifndef MOZART_BENCHUTILS_HH
+#define MOZART_BENCHUTILS_HH
+
+#include "mozart.hh"
+#include <benchmark/benchmark.h>
+#include <memory>
+
+namespace mozart {
+
+/**
+ * Fixture of the benchmarks, which gives each of them a fresh VM
+ * Nodes that must survive collectIfNeeded() have to be protected.
+ */
+class MozartBench : public ::benchmark::Fixture {
+public:
+  void SetUp(const ::benchmark::State& state);
+
+  void TearDown(const ::benchmark::State& state);
+
+protected:
+  /** Number of threads the environment lets parallelFor() use */
+  void setParallelism(size_t threads);
+
+  /** Run a full GC */
+  void collect();
+
+  /**
+   * Run a GC outside of the timing when the heap grew past `limit`, so that
+   * benchmarks that allocate run in a heap of bounded size
+   * Returns true when a GC ran.
+   */
+  bool collectIfNeeded(::benchmark::State& state,
+                       size_t limit = 32 * MegaBytes) {
+    if (vm->getMemoryManager().getAllocated() > limit) {
+      state.PauseTiming();
+      collect();
+      state.ResumeTiming();
+      return true;
+    }
+    return false;
+  }
+
+  /** Build the list [0 1 ... length-1] */
+  UnstableNode buildIntList(size_t length);
+
+  /** Build a list of `length` records r(a:I b:x c:F) */
+  UnstableNode buildRecordList(size_t length);
+
+  std::unique_ptr<VirtualMachineEnvironment> environment;
+  std::unique_ptr<VirtualMachine> virtualMachine;
+  VM vm;
+};
+
+}
+
+#endif
@@ -0,0 +1,154 @@
+#include "mozart.hh"
+#include <gtest/gtest.h>
+#include "testutils.hh"
+
+using namespace mozart;
+
+class BitArrayTest : public MozartTest {
+protected:
+  UnstableNode newBitArray(nativeint low, nativeint high) {
+    size_t width = (size_t) (high - low + 1);
+    return BitArray::build(vm, BitArray::wordCountFor(width), low, high);
+  }
+
+  void setAll(RichNode bitArray, std::initializer_list<nativeint> indices) {
+    for (nativeint i : indices) {
+      UnstableNode index = build(vm, i);
+      bitArray.as<BitArray>().set(vm, index);
+    }
+  }
+
+  std::vector<nativeint> toVector(UnstableNode&& list) {
+    std::vector<nativeint> result;
+    ozListForEach(vm, list, [&] (nativeint elem) {
+      result.push_back(elem);
+    }, "list");
+    return result;
+  }
+};
+
+TEST_F(BitArrayTest, SetClearTest) {
+  UnstableNode bitArray = newBitArray(-10, 200);
+  auto ba = RichNode(bitArray).as<BitArray>();
+
+  EXPECT_EQ(-10, ba.getLow());
+  EXPECT_EQ(200, ba.getHigh());
+  EXPECT_EQ(4u, ba.getArraySize());
+
+  for (nativeint i = -10; i <= 200; i += 3) {
+    UnstableNode index = build(vm, i);
+    ba.set(vm, index);
+  }
+
+  for (nativeint i = -10; i <= 200; i++) {
+    UnstableNode index = build(vm, i);
+    EXPECT_EQ((i + 10) % 3 == 0, ba.test(vm, index));
+  }
+
+  UnstableNode index = build(vm, 53);
+  ba.set(vm, index);
+  EXPECT_TRUE(ba.test(vm, index));
+  ba.clear(vm, index);
+  EXPECT_FALSE(ba.test(vm, index));
+
+  UnstableNode outside = build(vm, 201);
+  EXPECT_RAISE("BitArray.index",
+               RichNode(bitArray).as<BitArray>().test(vm, outside));
+}
+
+TEST_F(BitArrayTest, CardAndLists) {
+  UnstableNode bitArray = newBitArray(1, 130);
+  auto ba = RichNode(bitArray).as<BitArray>();
+
+  EXPECT_EQ(0u, ba.card(vm));
+  setAll(bitArray, {1, 2, 64, 65, 128, 130});
+  EXPECT_EQ(6u, ba.card(vm));
+
+  EXPECT_EQ((std::vector<nativeint> {1, 2, 64, 65, 128, 130}),
+            toVector(ba.toList(vm)));
+
+  std::vector<nativeint> complement = toVector(ba.complementToList(vm));
+  EXPECT_EQ(124u, complement.size());
+  EXPECT_EQ(3, complement.front());
+  EXPECT_EQ(129, complement.back());
+
+  UnstableNode empty = newBitArray(5, 4);
+  EXPECT_EQ(0u, RichNode(empty).as<BitArray>().card(vm));
+}
+
+TEST_F(BitArrayTest, BinaryOperations) {
+  UnstableNode left = newBitArray(0, 99);
+  UnstableNode right = newBitArray(0, 99);
+  setAll(left, {1, 2, 70});
+  setAll(right, {2, 3, 71});
+
+  auto l = RichNode(left).as<BitArray>();
+  EXPECT_FALSE(l.disjoint(vm, right));
+
+  UnstableNode copy = l.clone(vm);
+  RichNode(copy).as<BitArray>().disj(vm, right);
+  EXPECT_EQ((std::vector<nativeint> {1, 2, 3, 70, 71}),
+            toVector(RichNode(copy).as<BitArray>().toList(vm)));
+
+  copy = l.clone(vm);
+  RichNode(copy).as<BitArray>().conj(vm, right);
+  EXPECT_EQ((std::vector<nativeint> {2}),
+            toVector(RichNode(copy).as<BitArray>().toList(vm)));
+
+  copy = l.clone(vm);
+  RichNode(copy).as<BitArray>().exclDisj(vm, right);
+  EXPECT_EQ((std::vector<nativeint> {1, 3, 70, 71}),
+            toVector(RichNode(copy).as<BitArray>().toList(vm)));
+
+  copy = l.clone(vm);
+  RichNode(copy).as<BitArray>().nimpl(vm, right);
+  EXPECT_EQ((std::vector<nativeint> {1, 70}),
+            toVector(RichNode(copy).as<BitArray>().toList(vm)));
+  EXPECT_TRUE(RichNode(copy).as<BitArray>().disjoint(vm, right));
+
+  // The original is left untouched by operations on its clones
+  EXPECT_EQ((std::vector<nativeint> {1, 2, 70}), toVector(l.toList(vm)));
+
+  UnstableNode other = newBitArray(1, 100);
+  EXPECT_RAISE("BitArray.binop",
+               RichNode(left).as<BitArray>().disj(vm, other));
+}
+
+TEST_F(BitArrayTest, Subsumes) {
+  UnstableNode big = newBitArray(0, 199);
+  setAll(big, {10, 20, 100, 150});
+
+  UnstableNode aligned = newBitArray(0, 120);
+  setAll(aligned, {10, 100});
+  EXPECT_TRUE(RichNode(big).as<BitArray>().subsumes(vm, aligned));
+
+  UnstableNode shifted = newBitArray(7, 160);
+  setAll(shifted, {20, 150});
+  EXPECT_TRUE(RichNode(big).as<BitArray>().subsumes(vm, shifted));
+
+  setAll(shifted, {21});
+  EXPECT_FALSE(RichNode(big).as<BitArray>().subsumes(vm, shifted));
+
+  UnstableNode wider = newBitArray(0, 200);
+  EXPECT_FALSE(RichNode(big).as<BitArray>().subsumes(vm, wider));
+}
+
+TEST_F(BitArrayTest, SurvivesGC) {
+  UnstableNode bitArray = newBitArray(0, 999);
+  for (nativeint i = 0; i < 1000; i += 7) {
+    UnstableNode index = build(vm, i);
+    RichNode(bitArray).as<BitArray>().set(vm, index);
+  }
+
+  auto protectedBitArray = vm->protect(bitArray);
+
+  vm->requestGC();
+  vm->run();
+
+  auto ba = RichNode(*protectedBitArray).as<BitArray>();
+  EXPECT_EQ(143u, ba.card(vm));
+  for (nativeint i = 0; i < 1000; i++) {
+    UnstableNode index = build(vm, i);
+    EXPECT_EQ(i % 7 == 0, ba.test(vm, index));
+  }
+}
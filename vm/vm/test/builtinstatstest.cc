@@ -0,0 +1,87 @@
+#include "mozart.hh"
+#include <gtest/gtest.h>
+#include <sstream>
+#include "testutils.hh"
+
+using namespace mozart;
+
+namespace {
+  // Raises on a non-integer, suspends on an unbound variable
+  class Succ: public builtins::Builtin<Succ> {
+  public:
+    Succ(): Builtin("succ") {}
+
+    static void call(VM vm, builtins::In value, builtins::Out result) {
+      result = build(vm, getArgument<nativeint>(vm, value, "integer") + 1);
+    }
+  };
+}
+
+class BuiltinStatsTest : public MozartTest {
+protected:
+  virtual void SetUp() {
+    succ.setModuleName("Int");
+
+    // proc {$ X} try {Int.succ X _} catch _ then skip end end
+    ByteCode code[] = {
+      OpSetupExceptionHandler, 1,
+      OpReturn,
+      OpCallBuiltin2, 0, 0, 1,
+      OpPopExceptionHandler,
+      OpReturn
+    };
+    UnstableNode debugData = build(vm, unit);
+    UnstableNode codeArea = CodeArea::build(vm, 1, code, sizeof(code),
+                                            1, 2, vm->getAtom("f"), debugData);
+    UnstableNode succNode = build(vm, succ);
+    RichNode(codeArea).as<CodeArea>().getElementsArray()[0].init(vm, succNode);
+    procedure = vm->protect(Abstraction::build(vm, 0, codeArea));
+  }
+
+  void callSucc(UnstableNode argument) {
+    RichNode args[] = { argument };
+    new (vm) Thread(vm, vm->getCurrentSpace(), *procedure, 1, args);
+  }
+
+  Succ succ;
+  ProtectedNode procedure;
+};
+
+TEST_F(BuiltinStatsTest, Counts) {
+  auto& stats = vm->getBuiltinStats();
+  EXPECT_FALSE(stats.isEnabled());
+
+  stats.start();
+  for (nativeint i = 0; i < 3; i++)
+    callSucc(build(vm, i));
+
+  // A type error raises, an unbound variable suspends until it is bound
+  callSucc(build(vm, "foo"));
+  UnstableNode variable = Variable::build(vm);
+  callSucc(build(vm, variable));
+  testing::internal::CaptureStdout();
+  vm->run();
+  EXPECT_EQ("", testing::internal::GetCapturedStdout());
+
+  UnstableNode five = build(vm, 5);
+  unify(vm, variable, five);
+  vm->run();
+  stats.stop();
+
+  auto report = stats.getReport();
+  ASSERT_EQ(1u, report.size());
+  EXPECT_EQ("Int.succ", report[0].first);
+  EXPECT_EQ(6u, report[0].second.calls);
+  EXPECT_EQ(1u, report[0].second.raised);
+  EXPECT_EQ(1u, report[0].second.suspended);
+
+  std::stringstream output;
+  stats.dump(output);
+  EXPECT_NE(std::string::npos, output.str().find("suspended"));
+  EXPECT_NE(std::string::npos, output.str().find("  Int.succ\n"));
+
+  // Calls are not counted when the statistics are stopped
+  callSucc(build(vm, 0));
+  vm->run();
+  EXPECT_EQ(6u, stats.getReport()[0].second.calls);
+}
@@ -0,0 +1,93 @@
+#include "benchutils.hh"
+#include <string>
+
+using namespace mozart;
+
+namespace {
+  /**
+   * Mostly ASCII text, with a two-byte and a three-byte UTF-8 sequence
+   * every 64 characters, of about `size` bytes
+   */
+  std::string makeText(size_t size) {
+    std::string result;
+    result.reserve(size + 64);
+    while (result.size() < size) {
+      result += "The quick brown fox jumps over the lazy dog, 0123456789 ";
+      result += "caf\xc3\xa9 \xe2\x82\xac ";
+    }
+    return result;
+  }
+
+  const size_t textSize = 1 << 20;
+}
+
+BENCHMARK_F(MozartBench, UTF8ToUTF16)(benchmark::State& state) {
+  std::string text = makeText(textSize);
+  auto input = makeLString(text.data(), text.size());
+  for (auto _ : state) {
+    auto result = toUTF<char16_t>(input);
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+BENCHMARK_F(MozartBench, UTF8ToUTF16Scalar)(benchmark::State& state) {
+  std::string text = makeText(textSize);
+  auto input = makeLString(text.data(), text.size());
+  for (auto _ : state) {
+    auto result = ScalarUTFConvertor<char16_t, char>::call(input);
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+BENCHMARK_F(MozartBench, UTF8ToUTF32)(benchmark::State& state) {
+  std::string text = makeText(textSize);
+  auto input = makeLString(text.data(), text.size());
+  for (auto _ : state) {
+    auto result = toUTF<char32_t>(input);
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+BENCHMARK_F(MozartBench, ValidateUTF8)(benchmark::State& state) {
+  std::string text = makeText(textSize);
+  for (auto _ : state) {
+    auto result = validateUTF8(text.data(), text.size());
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+BENCHMARK_F(MozartBench, EncodeUTF8)(benchmark::State& state) {
+  std::string text = makeText(textSize);
+  auto input = makeLString(text.data(), text.size());
+  for (auto _ : state) {
+    auto result = encodeUTF8(input, EncodingVariant::none);
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+BENCHMARK_F(MozartBench, DecodeUTF8)(benchmark::State& state) {
+  std::string text = makeText(textSize);
+  auto input = makeLString(reinterpret_cast<const unsigned char*>(text.data()),
+                           text.size());
+  for (auto _ : state) {
+    auto result = decodeUTF8(input, EncodingVariant::none);
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+BENCHMARK_F(MozartBench, DecodeLatin1)(benchmark::State& state) {
+  std::string text = makeText(textSize);
+  auto input = makeLString(reinterpret_cast<const unsigned char*>(text.data()),
+                           text.size());
+  for (auto _ : state) {
+    auto result = decodeLatin1(input, EncodingVariant::none);
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
@@ -358,3 +358,18 @@ TEST_F(CodersTest, DecodeGeneric) {
   EXPECT_TRUE(
     decodeGeneric(b, ByteStringEncoding::utf32, EncodingVariant::none).isError());
 }
+
+TEST_F(CodersTest, DecodeLatin1Bulk) {
+  std::string encoded;
+  std::string decoded;
+  for (int i = 0; i < 100; ++i) {
+    unsigned char c = (i % 37 == 5) ? 0x80 + i : 'a' + i % 26;
+    encoded += (char) c;
+    char utf[4];
+    decoded.append(utf, toUTF((char32_t) c, utf));
+  }
+
+  auto res = decodeLatin1(makeLString(ustr(encoded.c_str()), encoded.size()),
+                          EncodingVariant::none);
+  EXPECT_EQ(makeLString(decoded.data(), decoded.size()), res);
+}
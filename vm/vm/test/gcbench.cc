@@ -0,0 +1,61 @@
+#include "benchutils.hh"
+#include "testutils.hh"
+
+using namespace mozart;
+
+// Garbage collection of a synthetic heap of records
+
+BENCHMARK_DEFINE_F(MozartBench, GCRecords)(benchmark::State& state) {
+  size_t length = state.range(0);
+  auto heap = vm->protect(buildRecordList(length));
+  collect();
+
+  for (auto _ : state)
+    collect();
+
+  state.SetItemsProcessed(state.iterations() * length);
+  state.counters["live"] = vm->getMemoryManager().getAllocated();
+}
+BENCHMARK_REGISTER_F(MozartBench, GCRecords)->Arg(10000)->Arg(200000)
+  ->Unit(benchmark::kMillisecond);
+
+// Cloning of a space whose root variable is bound to a list of records
+
+BENCHMARK_DEFINE_F(MozartBench, CloneSpace)(benchmark::State& state) {
+  size_t length = state.range(0);
+
+  // Only stable spaces are cloned: run a thread in it that returns at once
+  auto buildStableSpace = [&] {
+    Space* space = new (vm) Space(vm, vm->getCurrentSpace());
+
+    space->install();
+    UnstableNode records = buildRecordList(length);
+    unify(vm, *space->getRootVar(), records);
+    vm->getTopLevelSpace()->install();
+
+    StableNode* procedure = buildReturningProcedure(vm, "f", 1);
+    new (vm) Thread(vm, space, *procedure);
+    vm->run();
+
+    return space;
+  };
+
+  // Only collectIfNeeded() may run a GC, after which the space is rebuilt
+  vm->getPropertyRegistry().config.autoGC = false;
+  Space* space = buildStableSpace();
+
+  for (auto _ : state) {
+    Space* copy = space->clone(vm);
+    benchmark::DoNotOptimize(copy);
+
+    // Nothing keeps the space alive through a GC
+    if (collectIfNeeded(state)) {
+      state.PauseTiming();
+      space = buildStableSpace();
+      state.ResumeTiming();
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * length);
+}
+BENCHMARK_REGISTER_F(MozartBench, CloneSpace)->Arg(100)->Arg(10000);
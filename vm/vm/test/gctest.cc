@@ -1,4 +1,5 @@
 #include "mozart.hh"
+#include "coremodules.hh"
 #include <gtest/gtest.h>
 #include "testutils.hh"
 
@@ -316,3 +317,90 @@ TEST_F(GCTest, ForeignPointerMatchesGoodType) {
   std::shared_ptr<double> sharedDouble;
   EXPECT_FALSE(matches(vm, foreign, capture(sharedDouble)));
 }
+
+TEST_F(GCTest, Statistics) {
+  auto& registry = vm->getPropertyRegistry();
+
+  UnstableNode events;
+  ASSERT_TRUE(registry.get(vm, "gc.events", events));
+  auto protectedEvents = vm->protect(events);
+
+  size_t count = vm->getGCStatistics().getCount();
+  for (int i = 0; i < 2; i++) {
+    vm->requestGC();
+    vm->run();
+  }
+  EXPECT_EQ(count + 2, vm->getGCStatistics().getCount());
+
+  UnstableNode stats;
+  ASSERT_TRUE(registry.get(vm, "gc.stats", stats));
+  auto statsCount = Dottable(stats).dot(vm, build(vm, "count"));
+  EXPECT_EQ_INT(count + 2, statsCount);
+
+  UnstableNode history;
+  ASSERT_TRUE(registry.get(vm, "gc.history", history));
+  EXPECT_EQ(count + 2, ozListLength(vm, history));
+
+  // The first event on the stream is the first GC since we got it
+  RichNode stream = *protectedEvents;
+  ASSERT_TRUE(stream.is<Cons>());
+  RichNode event = *stream.as<Cons>().getHead();
+  auto number = Dottable(event).dot(vm, build(vm, "number"));
+  EXPECT_EQ_INT(count + 1, number);
+  EXPECT_TRUE(RichNode(*stream.as<Cons>().getTail()).is<Cons>());
+
+  // Some stable nodes are always alive, e.g., the property registry
+  auto live = Dottable(event).dot(vm, build(vm, "live"));
+  auto liveStable = Dottable(live).dot(vm, build(vm, "stable"));
+  ASSERT_TRUE(RichNode(liveStable).is<SmallInt>());
+  EXPECT_LT(0, RichNode(liveStable).as<SmallInt>().value());
+}
+
+TEST_F(GCTest, HeapCensus) {
+  auto& census = vm->getHeapCensus();
+  EXPECT_TRUE(vm->getPropertyRegistry().put(vm, "gc.census", true));
+  EXPECT_TRUE(census.isEnabled());
+
+  UnstableNode value = buildTuple(vm, "t",
+    buildTuple(vm, "triple", 1, 2, 3),
+    buildRecord(vm, buildArity(vm, "person", "age", "name"), 42, "ann"),
+    buildRecord(vm, buildArity(vm, "person", "age", "name"), 7, "bob"));
+  auto protectedValue = vm->protect(value);
+
+  vm->requestGC();
+  vm->run();
+
+  auto& entries = census.getEntries();
+  ASSERT_EQ(1u, entries.count("Tuple/3"));
+  EXPECT_LE(1u, entries.at("Tuple/3").count);
+  ASSERT_EQ(1u, entries.count("Record:person"));
+  EXPECT_EQ(2u, entries.at("Record:person").count);
+  EXPECT_LT(0u, entries.at("Record:person").bytes);
+
+  // Disabling the census keeps the last one
+  vm->getPropertyRegistry().put(vm, "gc.census", false);
+  vm->requestGC();
+  vm->run();
+  EXPECT_EQ(2u, census.getEntries().at("Record:person").count);
+}
+
+TEST_F(GCTest, SaveHeapCensusError) {
+  UnstableNode fileName = build(vm, "/nonexistent/dir/census.txt");
+  EXPECT_RAISE("os", builtins::ModProfile::SaveHeapCensus::call(
+    vm, fileName));
+}
+
+TEST_F(GCTest, ReifiedSpace) {
+  // A reified space must still refer to its space, not to its parent,
+  // after a GC
+
+  Space* space = new (vm) Space(vm, vm->getCurrentSpace());
+  auto reified = vm->protect(ReifiedSpace::build(vm, space));
+
+  vm->requestGC();
+  vm->run();
+
+  Space* result = RichNode(*reified).as<ReifiedSpace>().getSpace();
+  EXPECT_FALSE(result->isTopLevel());
+  EXPECT_EQ(vm->getTopLevelSpace(), result->getParent());
+}
@@ -0,0 +1,43 @@
+#include "mozart.hh"
+#include <gtest/gtest.h>
+#include <sstream>
+#include "testutils.hh"
+
+using namespace mozart;
+
+TEST(OpcodeStatsTest, Names) {
+  EXPECT_STREQ("MoveXX", OpcodeStats::getOpcodeName(OpMoveXX));
+  EXPECT_STREQ("CreateRecordUnifyK",
+               OpcodeStats::getOpcodeName(OpCreateRecordUnifyK));
+  EXPECT_EQ(nullptr, OpcodeStats::getOpcodeName(0xff));
+}
+
+TEST(OpcodeStatsTest, Counts) {
+  OpcodeStats stats;
+  stats.startRun();
+  stats.record(OpMoveXX);
+  stats.record(OpReturn);
+  stats.startRun();
+  stats.record(OpMoveXX);
+  stats.record(OpMoveXX);
+
+  EXPECT_EQ(3u, stats.getCount(OpMoveXX));
+  EXPECT_EQ(1u, stats.getCount(OpReturn));
+
+  std::stringstream dump;
+  stats.dump(dump);
+
+  if (OpcodeStats::isEnabled()) {
+    // No pair spans the two runs
+    EXPECT_EQ(1u, stats.getPairCount(OpMoveXX, OpReturn));
+    EXPECT_EQ(1u, stats.getPairCount(OpMoveXX, OpMoveXX));
+    EXPECT_EQ(0u, stats.getPairCount(OpReturn, OpMoveXX));
+    EXPECT_EQ("op MoveXX 3\nop Return 1\n"
+              "pair MoveXX MoveXX 1\npair MoveXX Return 1\n", dump.str());
+  } else {
+    EXPECT_EQ("op MoveXX 3\nop Return 1\n", dump.str());
+  }
+
+  stats.reset();
+  EXPECT_EQ(0u, stats.getCount(OpMoveXX));
+}
@@ -0,0 +1,61 @@
+#include "mozart.hh"
+#include <gtest/gtest.h>
+#include <sstream>
+#include <fstream>
+#include <cstdio>
+#include "testutils.hh"
+
+#ifdef MOZART_PERF_TRAMPOLINES
+#include <unistd.h>
+#endif
+
+using namespace mozart;
+
+class PerfMapTest : public MozartTest {};
+
+TEST_F(PerfMapTest, Trampolines) {
+  auto& perfMap = vm->getPerfMap();
+  EXPECT_FALSE(perfMap.isEnabled());
+
+#ifdef MOZART_PERF_TRAMPOLINES
+  // Map to a file of the test, in the working directory, instead of /tmp
+  std::stringstream fileName;
+  fileName << "perfmaptest-" << getpid() << ".map";
+  PerfMap::setMapFileName(fileName.str());
+#endif
+
+  perfMap.setEnabled(true);
+  if (!PerfMap::isSupported()) {
+    EXPECT_FALSE(perfMap.isEnabled());
+    return;
+  }
+
+  // caller calls callee, so that the emulator goes through both trampolines
+  StableNode* callee = buildReturningProcedure(vm, "callee", 2);
+  ByteCode code[] = { OpCallK, 0, 0, OpReturn };
+  UnstableNode debugData = buildRecord(
+    vm, buildArity(vm, "d", "file", "line"), "f.oz", 1);
+  UnstableNode codeArea = CodeArea::build(vm, 1, code, sizeof(code),
+                                          0, 0, vm->getAtom("caller"),
+                                          debugData);
+  RichNode(codeArea).as<CodeArea>().getElementsArray()[0].init(vm, *callee);
+  UnstableNode caller = Abstraction::build(vm, 0, codeArea);
+
+  new (vm) Thread(vm, vm->getCurrentSpace(), caller);
+  vm->run();
+  perfMap.setEnabled(false);
+
+  EXPECT_EQ(2u, perfMap.getTrampolineCount());
+
+#ifdef MOZART_PERF_TRAMPOLINES
+  std::stringstream map;
+  {
+    std::ifstream file(fileName.str());
+    map << file.rdbuf();
+  }
+  // The map stays open until the process exits, but it can be unlinked
+  std::remove(fileName.str().c_str());
+  EXPECT_NE(std::string::npos, map.str().find(" oz::caller (f.oz:1)\n"));
+  EXPECT_NE(std::string::npos, map.str().find(" oz::callee (f.oz:2)\n"));
+#endif
+}
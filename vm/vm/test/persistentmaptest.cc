@@ -0,0 +1,135 @@
+#include "mozart.hh"
+#include <gtest/gtest.h>
+#include <sstream>
+#include "testutils.hh"
+
+using namespace mozart;
+
+class PersistentMapTest : public MozartTest {
+protected:
+  UnstableNode putAll(UnstableNode map, nativeint from, nativeint to,
+                      nativeint factor) {
+    for (nativeint i = from; i < to; i++) {
+      UnstableNode key = build(vm, i);
+      UnstableNode value = build(vm, i * factor);
+      map = RichNode(map).as<PersistentMap>().put(vm, key, value);
+    }
+    return map;
+  }
+
+  bool hasMapping(RichNode map, nativeint key, nativeint value) {
+    UnstableNode keyNode = build(vm, key);
+    StableNode* found = map.as<PersistentMap>().lookup(vm, keyNode);
+    return (found != nullptr) && EXPECT_EQ_INT(value, *found);
+  }
+};
+
+TEST_F(PersistentMapTest, PutGetRemove) {
+  UnstableNode map = putAll(PersistentMap::build(vm), 0, 5000, 3);
+  EXPECT_EQ(5000u, RichNode(map).as<PersistentMap>().getSize());
+
+  for (nativeint i = 0; i < 5000; i++)
+    EXPECT_TRUE(hasMapping(map, i, i * 3));
+
+  UnstableNode missing = build(vm, 5000);
+  EXPECT_FALSE(RichNode(map).as<PersistentMap>().member(vm, missing));
+  EXPECT_RAISE(".", RichNode(map).as<PersistentMap>().get(vm, missing));
+
+  for (nativeint i = 0; i < 5000; i += 2) {
+    UnstableNode key = build(vm, i);
+    map = RichNode(map).as<PersistentMap>().remove(vm, key);
+  }
+  EXPECT_EQ(2500u, RichNode(map).as<PersistentMap>().getSize());
+
+  for (nativeint i = 0; i < 5000; i++) {
+    UnstableNode key = build(vm, i);
+    EXPECT_EQ(i % 2 == 1,
+              RichNode(map).as<PersistentMap>().member(vm, key));
+  }
+
+  for (nativeint i = 1; i < 5000; i += 2) {
+    UnstableNode key = build(vm, i);
+    map = RichNode(map).as<PersistentMap>().remove(vm, key);
+  }
+  EXPECT_EQ(0u, RichNode(map).as<PersistentMap>().getSize());
+  EXPECT_EQ(nullptr, RichNode(map).as<PersistentMap>().lookup(vm, missing));
+}
+
+TEST_F(PersistentMapTest, OldVersionsAreUnchanged) {
+  UnstableNode base = putAll(PersistentMap::build(vm), 0, 100, 1);
+  UnstableNode updated = putAll({vm, base}, 50, 150, 2);
+
+  UnstableNode key = build(vm, 10);
+  UnstableNode removed = RichNode(updated).as<PersistentMap>().remove(vm, key);
+
+  EXPECT_EQ(100u, RichNode(base).as<PersistentMap>().getSize());
+  EXPECT_EQ(150u, RichNode(updated).as<PersistentMap>().getSize());
+  EXPECT_EQ(149u, RichNode(removed).as<PersistentMap>().getSize());
+
+  EXPECT_TRUE(hasMapping(base, 60, 60));
+  EXPECT_TRUE(hasMapping(updated, 60, 120));
+  EXPECT_TRUE(hasMapping(updated, 10, 10));
+  EXPECT_FALSE(RichNode(removed).as<PersistentMap>().member(vm, key));
+  UnstableNode newKey = build(vm, 120);
+  EXPECT_FALSE(RichNode(base).as<PersistentMap>().member(vm, newKey));
+}
+
+TEST_F(PersistentMapTest, MixedKeysAndEquality) {
+  UnstableNode values[] = {
+    build(vm, "atom"), build(vm, 42), build(vm, true), build(vm, unit),
+    build(vm, unique_name_t(vm->getAtom("unique"))),
+    GlobalName::build(vm), build(vm, -7)
+  };
+
+  UnstableNode map1 = PersistentMap::build(vm);
+  for (auto& key : values)
+    map1 = RichNode(map1).as<PersistentMap>().put(vm, key, key);
+
+  UnstableNode map2 = PersistentMap::build(vm);
+  for (size_t i = sizeof(values) / sizeof(values[0]); i > 0; i--) {
+    RichNode key = values[i-1];
+    map2 = RichNode(map2).as<PersistentMap>().put(vm, key, key);
+  }
+
+  EXPECT_EQ(7u, RichNode(map1).as<PersistentMap>().getSize());
+  for (auto& key : values) {
+    UnstableNode value = RichNode(map2).as<PersistentMap>().get(vm, key);
+    EXPECT_TRUE(equals(vm, key, value));
+  }
+
+  EXPECT_TRUE(equals(vm, map1, map2));
+
+  UnstableNode key = build(vm, 42);
+  UnstableNode otherValue = build(vm, 43);
+  UnstableNode map3 = RichNode(map2).as<PersistentMap>().put(
+    vm, key, otherValue);
+  EXPECT_EQ(7u, RichNode(map3).as<PersistentMap>().getSize());
+  EXPECT_FALSE(equals(vm, map1, map3));
+}
+
+TEST_F(PersistentMapTest, SurvivesGC) {
+  UnstableNode map = putAll(PersistentMap::build(vm), 0, 1000, 5);
+  auto protectedMap = vm->protect(map);
+
+  vm->requestGC();
+  vm->run();
+
+  EXPECT_EQ(1000u, RichNode(*protectedMap).as<PersistentMap>().getSize());
+  for (nativeint i = 0; i < 1000; i++)
+    EXPECT_TRUE(hasMapping(*protectedMap, i, i * 5));
+}
+
+TEST_F(PersistentMapTest, PickleRoundTrip) {
+  UnstableNode map = putAll(PersistentMap::build(vm), -100, 100, 2);
+  UnstableNode key = build(vm, "key");
+  UnstableNode value = build(vm, "value");
+  map = RichNode(map).as<PersistentMap>().put(vm, key, value);
+
+  std::stringstream buffer;
+  pickle(vm, map, buffer);
+  UnstableNode result = unpickle(vm, buffer);
+
+  ASSERT_TRUE(RichNode(result).is<PersistentMap>());
+  EXPECT_EQ(201u, RichNode(result).as<PersistentMap>().getSize());
+  EXPECT_TRUE(equals(vm, map, result));
+}
@@ -0,0 +1,59 @@
+#include "benchutils.hh"
+#include <string>
+
+using namespace mozart;
+
+BENCHMARK_DEFINE_F(MozartBench, Pickle)(benchmark::State& state) {
+  auto value = vm->protect(buildRecordList(state.range(0)));
+
+  size_t size = 0;
+  for (auto _ : state) {
+    std::string bytes;
+    pickle(vm, *value, bytes);
+    size = bytes.size();
+    collectIfNeeded(state);
+  }
+
+  state.SetBytesProcessed(state.iterations() * size);
+}
+BENCHMARK_REGISTER_F(MozartBench, Pickle)->Arg(100)->Arg(10000);
+
+BENCHMARK_DEFINE_F(MozartBench, Unpickle)(benchmark::State& state) {
+  UnstableNode value = buildRecordList(state.range(0));
+  std::string bytes;
+  pickle(vm, value, bytes);
+  auto data = reinterpret_cast<const unsigned char*>(bytes.data());
+
+  for (auto _ : state) {
+    UnstableNode result = unpickle(vm, data, bytes.size());
+    benchmark::DoNotOptimize(result);
+    collectIfNeeded(state);
+  }
+
+  state.SetBytesProcessed(state.iterations() * bytes.size());
+}
+BENCHMARK_REGISTER_F(MozartBench, Unpickle)->Arg(100)->Arg(10000);
+
+BENCHMARK_DEFINE_F(MozartBench, UnpickleFile)(benchmark::State& state) {
+  // Mostly integers, the part that is predecoded in parallel
+  UnstableNode value = buildIntList(state.range(0));
+  std::string bytes;
+  pickle(vm, value, bytes);
+  auto data = reinterpret_cast<const unsigned char*>(bytes.data());
+
+  // 0 threads stands for the default, without predecoding
+  if (state.range(1) > 0) {
+    vm->getPropertyRegistry().put(vm, "pickle.parallel", true);
+    setParallelism(state.range(1));
+  }
+
+  for (auto _ : state) {
+    UnstableNode result = unpickleFile(vm, data, bytes.size());
+    benchmark::DoNotOptimize(result);
+    collectIfNeeded(state);
+  }
+
+  state.SetBytesProcessed(state.iterations() * bytes.size());
+}
+BENCHMARK_REGISTER_F(MozartBench, UnpickleFile)
+  ->Args({200000, 0})->Args({200000, 1})->Args({200000, 2})->Args({200000, 4});
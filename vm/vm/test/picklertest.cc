@@ -0,0 +1,480 @@
+#include "mozart.hh"
+#include "coremodules.hh"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <sstream>
+#include <cstring>
+#include <thread>
+#include "testutils.hh"
+
+using namespace mozart;
+
+namespace {
+  /** Environment whose parallelFor() runs on two threads */
+  class ParallelEnvironment: public VirtualMachineEnvironment {
+  public:
+    ParallelEnvironment(): parallelForCount(0), nextUUID(0) {}
+
+    UUID genUUID(VM vm) {
+      return UUID(1, ++nextUUID);
+    }
+
+    size_t getParallelism() {
+      return 2;
+    }
+
+    void parallelFor(size_t count,
+                     const std::function<void(size_t, size_t)>& body) {
+      parallelForCount++;
+      std::thread other(body, count / 2, count);
+      body(0, count / 2);
+      other.join();
+    }
+
+    size_t parallelForCount;
+  private:
+    std::uint64_t nextUUID;
+  };
+
+  /** Environment that shares code as BoostEnvironment does, for one block */
+  class SharingEnvironment: public VirtualMachineEnvironment {
+  public:
+    UUID genUUID(VM vm) {
+      return UUID(2, 1);
+    }
+
+    std::shared_ptr<const std::vector<ByteCode>> getSharedCodeBlock(
+      const UUID& uuid, const ByteCode* codeBlock, size_t size) {
+      auto block = std::make_shared<const std::vector<ByteCode>>(
+        codeBlock, codeBlock + size / sizeof(ByteCode));
+      sharedBlock = block;
+      return block;
+    }
+
+    std::weak_ptr<const std::vector<ByteCode>> sharedBlock;
+  };
+}
+
+class PicklerTest : public MozartTest {
+protected:
+  UnstableNode roundTrip(RichNode value) {
+    std::stringstream buffer;
+    pickle(vm, value, buffer);
+    return unpickle(vm, buffer);
+  }
+
+  std::string pickleToString(RichNode value) {
+    std::stringstream buffer;
+    pickle(vm, value, buffer);
+    return buffer.str();
+  }
+};
+
+TEST_F(PicklerTest, BuiltinTypes) {
+  unsigned char bytes[] = { 0, 1, 0xfe, 0xff };
+  UnstableNode value = buildTuple(vm, "data",
+    -42, 3.25, true, unit, "atom",
+    buildList(vm, 1, 2, 3),
+    buildRecord(vm, buildArity(vm, "rec", "a", "b"), 1.5, "x"),
+    String::build(vm, "unicode"),
+    ByteString::build(vm, newLString(vm, bytes, 4)));
+
+  UnstableNode result = roundTrip(value);
+  EXPECT_TRUE(equals(vm, value, result));
+
+  auto elements = RichNode(result).as<Tuple>();
+  EXPECT_EQ_INT(-42, *elements.getElement(0));
+  EXPECT_EQ(3.25, RichNode(*elements.getElement(1)).as<Float>().value());
+  ASSERT_TRUE(RichNode(*elements.getElement(8)).is<ByteString>());
+  auto& resultBytes = RichNode(*elements.getElement(8)).as<ByteString>().value();
+  ASSERT_EQ(4, resultBytes.length);
+  EXPECT_EQ(0xfe, resultBytes.string[2]);
+}
+
+TEST_F(PicklerTest, SharedSubterms) {
+  UnstableNode shared = buildRecord(vm, buildArity(vm, "shared", "a", "b"),
+                                    1, 2);
+  UnstableNode value = buildTuple(vm, "pair", shared, shared);
+
+  UnstableNode result = roundTrip(value);
+  EXPECT_TRUE(equals(vm, value, result));
+
+  auto pair = RichNode(result).as<Tuple>();
+  EXPECT_TRUE(RichNode(*pair.getElement(0)).isSameNode(*pair.getElement(1)));
+}
+
+TEST_F(PicklerTest, SharedArities) {
+  UnstableNode value = buildTuple(vm, "pair",
+    buildRecord(vm, buildArity(vm, "r", "x", "y"), 1, 2),
+    buildRecord(vm, buildArity(vm, "r", "x", "y"), 3, 4));
+
+  UnstableNode result = roundTrip(value);
+  EXPECT_TRUE(equals(vm, value, result));
+
+  auto pair = RichNode(result).as<Tuple>();
+  auto first = RichNode(*pair.getElement(0)).as<Record>();
+  auto second = RichNode(*pair.getElement(1)).as<Record>();
+  EXPECT_TRUE(RichNode(*first.getArity()).isSameNode(*second.getArity()));
+}
+
+TEST_F(PicklerTest, Deterministic) {
+  UnstableNode value = buildTuple(vm, "t",
+    buildRecord(vm, buildArity(vm, "r", "x", "y"), 1, 2),
+    buildRecord(vm, buildArity(vm, "s", "x", "z"), 3, 4),
+    buildList(vm, 0.5, "a", "a"));
+
+  EXPECT_EQ(pickleToString(value), pickleToString(value));
+}
+
+TEST_F(PicklerTest, ToString) {
+  // Large enough to go through several flushes of the buffer
+  UnstableNode value = buildTuple(vm, "t",
+    ByteString::build(vm, newLString(vm, std::vector<unsigned char>(10000, 7))),
+    buildList(vm, 1, 2.5, "atom"));
+
+  std::string bytes;
+  pickle(vm, value, bytes);
+  EXPECT_EQ(pickleToString(value), bytes);
+}
+
+TEST_F(PicklerTest, ResourcesAreRejected) {
+  UnstableNode initial = build(vm, 0);
+  UnstableNode cell = Cell::build(vm, initial);
+  UnstableNode value = buildTuple(vm, "t", 1, cell);
+  std::stringstream buffer;
+  EXPECT_RAISE("dp", pickle(vm, value, buffer));
+}
+
+TEST_F(PicklerTest, FuturesAreWaitedFor) {
+  UnstableNode future = ReadOnlyVariable::build(vm);
+  UnstableNode value = buildTuple(vm, "t", buildList(vm, 1, 2), future);
+  std::stringstream buffer;
+  MOZART_TRY(vm) {
+    pickle(vm, value, buffer);
+    ADD_FAILURE();
+  } MOZART_CATCH(vm, kind, node) {
+    EXPECT_EQ(ExceptionKind::ekWaitBefore, kind);
+  } MOZART_ENDTRY(vm);
+
+  // The builtin is retried once the future is bound
+  UnstableNode three = build(vm, 3);
+  BindableReadOnly(future).bindReadOnly(vm, three);
+  UnstableNode result = roundTrip(value);
+  EXPECT_TRUE(equals(vm, value, result));
+}
+
+TEST_F(PicklerTest, FromMemory) {
+  UnstableNode value = buildTuple(vm, "t", 1, 2.5, buildList(vm, "a", "b"));
+  std::string bytes = pickleToString(value);
+  auto data = reinterpret_cast<const unsigned char*>(bytes.data());
+
+  UnstableNode result = unpickle(vm, data, bytes.size());
+  EXPECT_TRUE(equals(vm, value, result));
+
+  for (size_t size: { (size_t) 0, (size_t) 7, bytes.size() / 2, bytes.size() - 1 })
+    EXPECT_RAISE("dp", unpickle(vm, data, size));
+}
+
+TEST_F(PicklerTest, Corrupted) {
+  // Node 1 has an unknown kind
+  unsigned char badKind[] = {
+    0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 99, 0, 0, 0, 0 };
+  EXPECT_RAISE("dp", unpickle(vm, badKind, sizeof(badKind)));
+
+  // The header claims more nodes than the input can hold
+  unsigned char badCount[] = {
+    0xff, 0xff, 0xff, 0xff, 0, 0, 0, 1, 0, 0, 0, 1, 4, 0, 0, 0, 0 };
+  EXPECT_RAISE("dp", unpickle(vm, badCount, sizeof(badCount)));
+
+  EXPECT_RAISE("dp", unpickleLazily(vm, badKind, sizeof(badKind)));
+
+  // A failed unpickling does not keep the owner of its input
+  std::shared_ptr<const std::string> owner(new std::string(
+    reinterpret_cast<const char*>(badKind), sizeof(badKind)));
+  EXPECT_RAISE("dp", unpickleShared(vm, owner));
+  EXPECT_EQ(1, owner.use_count());
+}
+
+TEST_F(PicklerTest, Compressed) {
+  UnstableNode value = buildTuple(vm, "t",
+    ByteString::build(vm, newLString(vm, std::vector<unsigned char>(10000, 7))),
+    buildList(vm, 1, 2.5, "atom"));
+
+  PickleOptions options;
+  options.compression = PickleCompression::zlib;
+  options.level = 1;
+
+  UnstableNode noReplacement = build(vm, vm->coreatoms.nil);
+  std::string bytes;
+  if (!isPickleCompressionSupported(PickleCompression::zlib)) {
+    EXPECT_RAISE("dp", pickle(vm, value, noReplacement, options, bytes));
+    return;
+  }
+
+  pickle(vm, value, noReplacement, options, bytes);
+  EXPECT_LT(bytes.size(), pickleToString(value).size());
+
+  auto data = reinterpret_cast<const unsigned char*>(bytes.data());
+  UnstableNode result = unpickle(vm, data, bytes.size());
+  EXPECT_TRUE(equals(vm, value, result));
+
+  for (size_t size: { (size_t) 4, (size_t) 10, bytes.size() - 1 })
+    EXPECT_RAISE("dp", unpickle(vm, data, size));
+}
+
+TEST_F(PicklerTest, CompressedLarge) {
+  if (!isPickleCompressionSupported(PickleCompression::zlib))
+    return;
+
+  // Inflates to several chunks of zlib output
+  std::vector<unsigned char> bytes(3 * 1024 * 1024);
+  for (size_t i = 0; i < bytes.size(); i++)
+    bytes[i] = (unsigned char) (i % 251);
+  UnstableNode value = ByteString::build(vm, newLString(vm, bytes));
+
+  PickleOptions options;
+  options.compression = PickleCompression::zlib;
+  options.level = 1;
+
+  UnstableNode noReplacement = build(vm, vm->coreatoms.nil);
+  std::string compressed;
+  pickle(vm, value, noReplacement, options, compressed);
+  EXPECT_LT(compressed.size(), bytes.size());
+
+  UnstableNode result = unpickle(
+    vm, reinterpret_cast<const unsigned char*>(compressed.data()),
+    compressed.size());
+  EXPECT_TRUE(equals(vm, value, result));
+}
+
+TEST_F(PicklerTest, CompressedManyNodes) {
+  if (!isPickleCompressionSupported(PickleCompression::zlib))
+    return;
+
+  // Spans many windows of inflated input, with nodes across their bounds
+  UnstableNode value = buildNil(vm);
+  for (nativeint i = 0; i < 20000; i++)
+    value = buildCons(vm, buildTuple(vm, "t", i, 0.5), value);
+
+  PickleOptions options;
+  options.compression = PickleCompression::zlib;
+
+  UnstableNode noReplacement = build(vm, vm->coreatoms.nil);
+  std::string compressed;
+  pickle(vm, value, noReplacement, options, compressed);
+
+  UnstableNode result = unpickle(
+    vm, reinterpret_cast<const unsigned char*>(compressed.data()),
+    compressed.size());
+  EXPECT_TRUE(equals(vm, value, result));
+}
+
+TEST_F(PicklerTest, CompressedResourcesAreRejected) {
+  if (!isPickleCompressionSupported(PickleCompression::zlib))
+    return;
+
+  PickleOptions options;
+  options.compression = PickleCompression::zlib;
+
+  UnstableNode initial = build(vm, 0);
+  UnstableNode cell = Cell::build(vm, initial);
+  UnstableNode bad = buildTuple(vm, "t", 1, cell);
+  UnstableNode noReplacement = build(vm, vm->coreatoms.nil);
+  std::string bytes;
+  EXPECT_RAISE("dp", pickle(vm, bad, noReplacement, options, bytes));
+
+  // Nothing was written, and compression still works afterwards
+  EXPECT_TRUE(bytes.empty());
+  UnstableNode value = buildList(vm, 1, 2.5, "atom");
+  pickle(vm, value, noReplacement, options, bytes);
+  UnstableNode result = unpickle(
+    vm, reinterpret_cast<const unsigned char*>(bytes.data()), bytes.size());
+  EXPECT_TRUE(equals(vm, value, result));
+}
+
+TEST_F(PicklerTest, SaveWithOptionsError) {
+  UnstableNode value = buildList(vm, 1, 2);
+  UnstableNode noReplacement = build(vm, vm->coreatoms.nil);
+  UnstableNode fileName = build(vm, "/nonexistent/dir/value.ozp");
+  UnstableNode compression = build(vm, "none");
+  UnstableNode level = build(vm, 1);
+  EXPECT_RAISE("os", builtins::ModPickle::SaveWithOptions::call(
+    vm, value, noReplacement, fileName, compression, level));
+}
+
+TEST_F(PicklerTest, LoadError) {
+  // Neither a missing file nor a directory are corrupted pickles
+  UnstableNode result;
+  UnstableNode missing = build(vm, "/nonexistent/dir/value.ozp");
+  EXPECT_RAISE("os", builtins::ModPickle::Load::call(vm, missing, result));
+  UnstableNode directory = build(vm, ".");
+  EXPECT_RAISE("os", builtins::ModPickle::Load::call(vm, directory, result));
+}
+
+TEST_F(PicklerTest, SharedByteStrings) {
+  std::vector<unsigned char> large(10000, 7);
+  UnstableNode value = buildTuple(vm, "t",
+    ByteString::build(vm, newLString(vm, large)),
+    ByteString::build(vm, newLString(vm, std::vector<unsigned char>(10, 1))));
+  std::shared_ptr<const std::string> buffer(
+    new std::string(pickleToString(value)));
+
+  auto inBuffer = [&buffer] (const unsigned char* bytes) {
+    auto begin = reinterpret_cast<const unsigned char*>(buffer->data());
+    return (bytes >= begin) && (bytes < begin + buffer->size());
+  };
+  auto byteString = [] (ProtectedNode& tuple, size_t index) {
+    RichNode element = RichNode(*tuple).as<Tuple>().getElements(index);
+    return element.as<ByteString>().value();
+  };
+
+  {
+    auto result = vm->protect(unpickleShared(vm, buffer));
+    EXPECT_TRUE(equals(vm, value, *result));
+    EXPECT_TRUE(inBuffer(byteString(result, 0).string));
+    EXPECT_FALSE(inBuffer(byteString(result, 1).string));
+
+    // The GC keeps the large byte string in the buffer
+    vm->requestGC();
+    vm->run();
+    EXPECT_LT(1, buffer.use_count());
+    auto bytes = byteString(result, 0);
+    EXPECT_TRUE(inBuffer(bytes.string));
+    EXPECT_EQ(0, std::memcmp(large.data(), bytes.string, large.size()));
+  }
+
+  // Once the byte string is dead, the next GC releases the buffer
+  vm->requestGC();
+  vm->run();
+  EXPECT_EQ(1, buffer.use_count());
+}
+
+TEST_F(PicklerTest, LazyCodeAreas) {
+  ByteCode code[] = { OpMoveXX, 0, 1, OpReturn };
+  UnstableNode debugData = build(vm, unit);
+  UnstableNode codeArea = CodeArea::build(vm, 0, code, sizeof(code),
+                                          1, 2, vm->getAtom("f"), debugData);
+  UnstableNode abstraction = Abstraction::build(vm, 0, codeArea);
+  std::string bytes = pickleToString(abstraction);
+  std::vector<unsigned char> image(bytes.begin(), bytes.end());
+
+  // Unpickle into a fresh VM, so that nothing is found in the GlobalNodes
+  VirtualMachine otherVirtualMachine(*environment,
+                                     { 10 * MegaBytes, 20 * MegaBytes });
+  VM other = &otherVirtualMachine;
+
+  auto result = other->protect(
+    unpickleLazily(other, image.data(), image.size()));
+  auto resultCodeArea = [&result] () {
+    return RichNode(
+      *RichNode(*result).as<Abstraction>().getBody()).as<CodeArea>();
+  };
+  EXPECT_FALSE(resultCodeArea().isCodeBlockDecoded());
+
+  // The image is not needed any more, even before the code is decoded
+  std::fill(image.begin(), image.end(), 0xff);
+  std::vector<unsigned char>().swap(image);
+
+  // The code area keeps its own byte-code across GCs until it is decoded
+  other->requestGC();
+  other->run();
+  EXPECT_FALSE(resultCodeArea().isCodeBlockDecoded());
+
+  size_t arity, Xcount;
+  ProgramCounter start;
+  StaticArray<StableNode> Gs, Ks;
+  RichNode(*result).as<Abstraction>().getCallInfo(other, arity, start, Xcount,
+                                                  Gs, Ks);
+  EXPECT_TRUE(resultCodeArea().isCodeBlockDecoded());
+  EXPECT_EQ(1u, arity);
+  EXPECT_EQ(2u, Xcount);
+  EXPECT_EQ(0, std::memcmp(code, start, sizeof(code)));
+}
+
+TEST_F(PicklerTest, SharedCodeBlocks) {
+  ByteCode code[] = { OpMoveXX, 0, 1, OpReturn };
+  UnstableNode debugData = build(vm, unit);
+  UnstableNode codeArea = CodeArea::build(vm, 0, code, sizeof(code),
+                                          1, 2, vm->getAtom("f"), debugData);
+  UnstableNode abstraction = Abstraction::build(vm, 0, codeArea);
+  std::string bytes = pickleToString(abstraction);
+
+  SharingEnvironment sharingEnvironment;
+  VirtualMachine otherVirtualMachine(sharingEnvironment,
+                                     { 10 * MegaBytes, 20 * MegaBytes });
+  VM other = &otherVirtualMachine;
+
+  {
+    auto result = other->protect(unpickleLazily(
+      other, reinterpret_cast<const unsigned char*>(bytes.data()),
+      bytes.size()));
+
+    size_t arity, Xcount;
+    ProgramCounter start;
+    StaticArray<StableNode> Gs, Ks;
+    RichNode(*result).as<Abstraction>().getCallInfo(other, arity, start,
+                                                    Xcount, Gs, Ks);
+    auto block = sharingEnvironment.sharedBlock.lock();
+    ASSERT_NE(nullptr, block);
+    EXPECT_EQ(block->data(), start);
+    block.reset();
+
+    // The code area keeps the shared block alive across GCs
+    other->requestGC();
+    other->run();
+    EXPECT_FALSE(sharingEnvironment.sharedBlock.expired());
+  }
+
+  // Once the code area is dead, the next GCs release the block
+  other->requestGC();
+  other->run();
+  other->requestGC();
+  other->run();
+  EXPECT_TRUE(sharingEnvironment.sharedBlock.expired());
+}
+
+TEST_F(PicklerTest, Parallel) {
+  // Large enough to be predecoded in parallel
+  const size_t count = 20000;
+  UnstableNode ints = buildNil(vm);
+  UnstableNode floats = buildNil(vm);
+  for (size_t i = 0; i < count; i++) {
+    ints = buildCons(vm, (nativeint) (i * 7919), ints);
+    floats = buildCons(vm, 1.0 / (i + 1), floats);
+  }
+
+  ByteCode code[] = { OpMoveXX, 0, 1, OpReturn };
+  UnstableNode debugData = build(vm, unit);
+  UnstableNode codeArea = CodeArea::build(vm, 0, code, sizeof(code),
+                                          1, 2, vm->getAtom("f"), debugData);
+  UnstableNode value = buildTuple(vm, "t", ints, floats,
+                                  Abstraction::build(vm, 0, codeArea));
+  std::string bytes = pickleToString(value);
+
+  ParallelEnvironment parallelEnvironment;
+  VirtualMachine otherVirtualMachine(parallelEnvironment,
+                                     { 10 * MegaBytes, 20 * MegaBytes });
+  VM other = &otherVirtualMachine;
+
+  auto data = reinterpret_cast<const unsigned char*>(bytes.data());
+
+  // Predecoding is off by default
+  UnstableNode sequential = unpickleFile(other, data, bytes.size());
+  EXPECT_EQ(0u, parallelEnvironment.parallelForCount);
+
+  EXPECT_TRUE(other->getPropertyRegistry().put(other, "pickle.parallel",
+                                               true));
+  UnstableNode result = unpickleFile(other, data, bytes.size());
+  EXPECT_EQ(1u, parallelEnvironment.parallelForCount);
+  EXPECT_TRUE(equals(other, sequential, result));
+
+  // Pickling is deterministic, so the same value gives the same bytes
+  std::stringstream buffer;
+  pickle(other, result, buffer);
+  EXPECT_EQ(bytes, buffer.str());
+
+  // Only files are decoded in parallel, not messages
+  UnstableNode message = unpickle(other, data, bytes.size());
+  EXPECT_EQ(1u, parallelEnvironment.parallelForCount);
+  EXPECT_TRUE(equals(other, message, result));
+}
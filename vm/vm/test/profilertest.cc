@@ -0,0 +1,101 @@
+#include "mozart.hh"
+#include <gtest/gtest.h>
+#include "testutils.hh"
+
+using namespace mozart;
+
+class ProfilerTest : public MozartTest {
+protected:
+  void pushFrame(ThreadStack& stack, StableNode* abstraction) {
+    stack.push_front_new(vm, abstraction, nullptr, 0, nullptr, nullptr,
+                         nullptr, DebugEntry());
+  }
+};
+
+TEST_F(ProfilerTest, StartStop) {
+  auto& profiler = vm->getProfiler();
+  EXPECT_FALSE(profiler.isRunning());
+
+  profiler.start();
+  EXPECT_TRUE(profiler.isRunning());
+  EXPECT_EQ(0u, profiler.getSampleCount());
+
+  profiler.stop();
+  EXPECT_FALSE(profiler.isRunning());
+}
+
+TEST_F(ProfilerTest, CollapsedStacks) {
+  auto& profiler = vm->getProfiler();
+  StableNode* main = buildReturningProcedure(vm, "main", 1);
+  StableNode* loop = buildReturningProcedure(vm, "loop", 5);
+  StableNode* leaf = buildReturningProcedure(vm, "leaf", 9);
+
+  ThreadStack stack;
+  pushFrame(stack, main);
+  pushFrame(stack, loop);
+
+  profiler.start();
+  profiler.sample(vm, leaf, stack);
+  profiler.sample(vm, leaf, stack);
+  profiler.sample(vm, loop, stack);
+  profiler.stop();
+
+  EXPECT_EQ(3u, profiler.getSampleCount());
+  EXPECT_EQ(
+    "main (f.oz:1);loop (f.oz:5);leaf (f.oz:9) 2\n"
+    "main (f.oz:1);loop (f.oz:5);loop (f.oz:5) 1\n",
+    profiler.getCollapsedStacks());
+
+  auto counts = profiler.getProcedureCounts();
+  EXPECT_EQ(2u, counts["leaf (f.oz:9)"].self);
+  EXPECT_EQ(1u, counts["loop (f.oz:5)"].self);
+  EXPECT_EQ(3u, counts["loop (f.oz:5)"].total);
+  EXPECT_EQ(0u, counts["main (f.oz:1)"].self);
+  EXPECT_EQ(3u, counts["main (f.oz:1)"].total);
+
+  stack.clear(vm);
+}
+
+TEST_F(ProfilerTest, Allocations) {
+  auto& profiler = vm->getAllocationProfiler();
+  StableNode* leaf = buildReturningProcedure(vm, "leaf", 9);
+  StableNode* running = leaf;
+  ThreadStack stack;
+  pushFrame(stack, buildReturningProcedure(vm, "main", 1));
+
+  profiler.start(vm, 256);
+  EXPECT_TRUE(profiler.isRunning());
+
+  // Allocations outside of a thread are not sampled
+  for (int i = 0; i < 100; i++)
+    buildTuple(vm, "t", i, i, i, i);
+  EXPECT_EQ(0u, profiler.getSampleCount());
+
+  profiler.enterThread(&running, &stack);
+  for (int i = 0; i < 100; i++)
+    buildTuple(vm, "t", i, i, i, i);
+  profiler.leaveThread();
+
+  size_t sampleCount = profiler.getSampleCount();
+  EXPECT_LT(0u, sampleCount);
+
+  std::string profile = profiler.getPprofProfile(vm);
+  EXPECT_NE(std::string::npos, profile.find("leaf"));
+  EXPECT_NE(std::string::npos, profile.find("main"));
+  EXPECT_NE(std::string::npos, profile.find("f.oz"));
+  EXPECT_NE(std::string::npos, profile.find("alloc_space"));
+
+  // The samples survive a GC
+  auto protectedLeaf = vm->protect(*leaf);
+  stack.clear(vm);
+  vm->requestGC();
+  vm->run();
+  EXPECT_EQ(profile, profiler.getPprofProfile(vm));
+
+  profiler.stop(vm);
+  EXPECT_FALSE(profiler.isRunning());
+  profiler.enterThread(&running, &stack);
+  buildTuple(vm, "t", 1, 2, 3, 4);
+  profiler.leaveThread();
+  EXPECT_EQ(sampleCount, profiler.getSampleCount());
+}
@@ -0,0 +1,180 @@
+#include "benchutils.hh"
+#include <cstdio>
+#include <vector>
+
+using namespace mozart;
+
+// Nodes
+
+BENCHMARK_F(MozartBench, BuildSmallInt)(benchmark::State& state) {
+  nativeint i = 0;
+  for (auto _ : state) {
+    UnstableNode node = build(vm, i++);
+    benchmark::DoNotOptimize(node);
+  }
+}
+
+BENCHMARK_F(MozartBench, BuildTuple)(benchmark::State& state) {
+  for (auto _ : state) {
+    UnstableNode node = buildTuple(vm, "t", 1, 2.5, "atom");
+    benchmark::DoNotOptimize(node);
+    collectIfNeeded(state);
+  }
+}
+
+BENCHMARK_F(MozartBench, CopyNode)(benchmark::State& state) {
+  UnstableNode tuple = buildTuple(vm, "t", 1, 2.5, "atom");
+  for (auto _ : state) {
+    UnstableNode copy(vm, tuple);
+    benchmark::DoNotOptimize(copy);
+  }
+}
+
+// Unification of large terms
+
+// Unifying two terms may make one of them a reference to the other, so each
+// iteration gets fresh terms
+
+BENCHMARK_DEFINE_F(MozartBench, UnifyGroundLists)(benchmark::State& state) {
+  size_t length = state.range(0);
+  for (auto _ : state) {
+    collectIfNeeded(state);
+    state.PauseTiming();
+    UnstableNode left = buildRecordList(length);
+    UnstableNode right = buildRecordList(length);
+    state.ResumeTiming();
+
+    unify(vm, left, right);
+  }
+  state.SetItemsProcessed(state.iterations() * length);
+}
+BENCHMARK_REGISTER_F(MozartBench, UnifyGroundLists)->Arg(1000)->Arg(100000);
+
+BENCHMARK_DEFINE_F(MozartBench, UnifyBindLists)(benchmark::State& state) {
+  size_t length = state.range(0);
+  for (auto _ : state) {
+    collectIfNeeded(state);
+    state.PauseTiming();
+    UnstableNode values = buildIntList(length);
+    UnstableNode variables = buildNil(vm);
+    for (size_t i = 0; i < length; i++)
+      variables = buildCons(vm, Variable::build(vm), variables);
+    state.ResumeTiming();
+
+    unify(vm, values, variables);
+  }
+  state.SetItemsProcessed(state.iterations() * length);
+}
+BENCHMARK_REGISTER_F(MozartBench, UnifyBindLists)->Arg(1000)->Arg(100000);
+
+BENCHMARK_DEFINE_F(MozartBench, EqualsLists)(benchmark::State& state) {
+  size_t length = state.range(0);
+  for (auto _ : state) {
+    collectIfNeeded(state);
+    state.PauseTiming();
+    UnstableNode left = buildRecordList(length);
+    UnstableNode right = buildRecordList(length);
+    state.ResumeTiming();
+
+    bool result = equals(vm, left, right);
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetItemsProcessed(state.iterations() * length);
+}
+BENCHMARK_REGISTER_F(MozartBench, EqualsLists)->Arg(1000)->Arg(100000);
+
+// Records
+
+BENCHMARK_F(MozartBench, RecordLookupFeature)(benchmark::State& state) {
+  const size_t width = 16;
+  UnstableField fields[width];
+  for (size_t i = 0; i < width; i++) {
+    char name[16];
+    std::snprintf(name, sizeof(name), "f%02d", (int) i);
+    fields[i].feature = build(vm, vm->getAtom(name));
+    fields[i].value = build(vm, (nativeint) i);
+  }
+  UnstableNode label = build(vm, "r");
+  UnstableNode record = buildRecordDynamic(vm, label, width, fields);
+  UnstableNode feature = build(vm, "f11");
+
+  for (auto _ : state) {
+    UnstableNode value;
+    Dottable(record).lookupFeature(vm, feature, value);
+    benchmark::DoNotOptimize(value);
+  }
+}
+
+BENCHMARK_F(MozartBench, TupleLookupFeature)(benchmark::State& state) {
+  UnstableNode tuple = buildTuple(vm, "t", 0, 1, 2, 3, 4, 5, 6, 7);
+  for (auto _ : state) {
+    UnstableNode value;
+    Dottable(tuple).lookupFeature(vm, 5, value);
+    benchmark::DoNotOptimize(value);
+  }
+}
+
+// Dictionaries
+
+BENCHMARK_DEFINE_F(MozartBench, DictionaryPut)(benchmark::State& state) {
+  size_t keyCount = state.range(0);
+  auto dictionary = vm->protect(Dictionary::build(vm));
+  nativeint i = 0;
+  for (auto _ : state) {
+    UnstableNode key = build(vm, i % (nativeint) keyCount);
+    UnstableNode value = build(vm, i);
+    DictionaryLike(*dictionary).dictPut(vm, key, value);
+    i++;
+    collectIfNeeded(state);
+  }
+}
+BENCHMARK_REGISTER_F(MozartBench, DictionaryPut)->Arg(64)->Arg(65536);
+
+BENCHMARK_DEFINE_F(MozartBench, DictionaryGet)(benchmark::State& state) {
+  size_t keyCount = state.range(0);
+  UnstableNode dictionary = Dictionary::build(vm);
+  std::vector<UnstableNode> keys;
+  for (size_t i = 0; i < keyCount; i++) {
+    char name[16];
+    std::snprintf(name, sizeof(name), "key%d", (int) i);
+    keys.push_back(build(vm, vm->getAtom(name)));
+    UnstableNode value = build(vm, (nativeint) i);
+    DictionaryLike(dictionary).dictPut(vm, keys.back(), value);
+  }
+
+  size_t i = 0;
+  for (auto _ : state) {
+    UnstableNode value = DictionaryLike(dictionary).dictGet(
+      vm, keys[i++ % keyCount]);
+    benchmark::DoNotOptimize(value);
+  }
+}
+BENCHMARK_REGISTER_F(MozartBench, DictionaryGet)->Arg(64)->Arg(65536);
+
+// Atoms
+
+BENCHMARK_F(MozartBench, AtomInternExisting)(benchmark::State& state) {
+  const size_t count = 1024;
+  std::vector<std::string> names;
+  for (size_t i = 0; i < count; i++) {
+    names.push_back("existingAtom" + std::to_string(i));
+    vm->getAtom(names.back());
+  }
+
+  size_t i = 0;
+  for (auto _ : state) {
+    atom_t atom = vm->getAtom(names[i++ % count]);
+    benchmark::DoNotOptimize(atom);
+  }
+}
+
+BENCHMARK_F(MozartBench, AtomInternNew)(benchmark::State& state) {
+  size_t i = 0;
+  for (auto _ : state) {
+    char name[32];
+    int length = std::snprintf(name, sizeof(name), "newAtom%lu",
+                               (unsigned long) i++);
+    atom_t atom = vm->getAtom((size_t) length, name);
+    benchmark::DoNotOptimize(atom);
+  }
+}
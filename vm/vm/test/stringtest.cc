@@ -220,3 +220,111 @@ TEST_F(StringTest, Search) {
     EXPECT_FALSE(RichNode(end).as<Boolean>().value());
   }
 }
+
+TEST_F(StringTest, SearchLString) {
+  std::string haystack;
+  for (int i = 0; i < 200; ++i)
+    haystack += (char) ('a' + (i * 7) % 13);
+  auto hay = makeLString(haystack.data(), haystack.size());
+
+  // Needles on both sides of the Boyer-Moore-Horspool threshold, found and
+  // not found, are checked against std::search.
+  for (size_t from = 0; from < 150; from += 11) {
+    for (size_t length = 0; length <= 20; ++length) {
+      std::string needles[] = {
+        haystack.substr(from, length),
+        haystack.substr(from, length) + "z",
+        "z" + haystack.substr(from, length)
+      };
+      for (auto&& needle : needles) {
+        auto expected = std::search(haystack.data(),
+                                    haystack.data() + haystack.size(),
+                                    needle.data(),
+                                    needle.data() + needle.size());
+        EXPECT_EQ(expected, searchLString(
+          hay, makeLString(needle.data(), needle.size())));
+      }
+    }
+  }
+
+  auto shortHay = makeLString("ab", 2);
+  EXPECT_EQ(shortHay.end(), searchLString(shortHay, hay));
+}
+
+TEST_F(StringTest, SearchAnyLString) {
+  auto hay = makeLString("key=value;other,last");
+  auto semicolon = makeLString(";");
+  auto comma = makeLString(",");
+  auto other = makeLString("other");
+  auto missing = makeLString("missing");
+  size_t which = 42;
+
+  const mut::BaseLString<char>* delimiters[] = {&comma, &semicolon};
+  EXPECT_EQ(hay.begin() + 9, searchAnyLString(hay, delimiters, 2, which));
+  EXPECT_EQ(1u, which);
+
+  const mut::BaseLString<char>* overlapping[] = {&missing, &semicolon, &other};
+  EXPECT_EQ(hay.begin() + 9, searchAnyLString(hay, overlapping, 3, which));
+  EXPECT_EQ(1u, which);
+
+  const mut::BaseLString<char>* words[] = {&missing, &other};
+  EXPECT_EQ(hay.begin() + 10, searchAnyLString(hay, words, 2, which));
+  EXPECT_EQ(1u, which);
+
+  which = 42;
+  const mut::BaseLString<char>* none[] = {&missing};
+  EXPECT_EQ(hay.end(), searchAnyLString(hay, none, 1, which));
+  EXPECT_EQ(hay.end(), searchAnyLString(hay, none, 0, which));
+  EXPECT_EQ(42u, which);
+}
+
+TEST_F(StringTest, FindAnyByteKernels) {
+  SIMDLevel best = internal::detectSIMDLevel();
+  SIMDLevel levels[] = {
+    SIMDLevel::scalar, SIMDLevel::sse2, SIMDLevel::avx2
+  };
+  const unsigned char bytes[] = { 0xe9, ';', 0x80, ',' };
+
+  std::vector<unsigned char> hay(100, 'x');
+  const unsigned char* begin = hay.data();
+  const unsigned char* end = begin + hay.size();
+
+  for (auto level : levels) {
+    if (level > best)
+      break;
+
+    for (size_t count = 1; count <= internal::maxFindAnyBytes; ++count) {
+      EXPECT_EQ(end, internal::findAnyByte(begin, end, bytes, count, level));
+
+      for (size_t pos = 0; pos < hay.size(); ++pos) {
+        hay[pos] = bytes[count - 1];
+        EXPECT_EQ(begin + pos,
+                  internal::findAnyByte(begin, end, bytes, count, level));
+        EXPECT_EQ(begin + pos,
+                  internal::findAnyByte(begin, begin + pos, bytes, count,
+                                        level));
+        hay[pos] = 'x';
+      }
+    }
+  }
+}
+
+TEST_F(StringTest, SearchAnyLStringManyFirstBytes) {
+  // More distinct first bytes than the vector kernels look for at once
+  std::string text = std::string(70, '.') + "cd" + std::string(30, '.') + "e";
+  auto hay = makeLString(text.c_str());
+  auto a = makeLString("a");
+  auto b = makeLString("b");
+  auto c = makeLString("cd");
+  auto d = makeLString("d");
+  auto e = makeLString("e");
+  size_t which = 42;
+
+  const mut::BaseLString<char>* five[] = {&a, &b, &e, &d, &c};
+  EXPECT_EQ(hay.begin() + 70, searchAnyLString(hay, five, 5, which));
+  EXPECT_EQ(4u, which);
+
+  const mut::BaseLString<char>* four[] = {&a, &b, &e, &d};
+  EXPECT_EQ(hay.begin() + 71, searchAnyLString(hay, four, 4, which));
+  EXPECT_EQ(3u, which);
+}
@@ -49,7 +49,19 @@ std::unique_ptr<mozart::VirtualMachineEnvironment> makeTestEnvironment() {
   return std::unique_ptr<TestEnvironment>(new TestEnvironment());
 }
 
-namespace mozart { namespace mut {
+namespace mozart {
+
+StableNode* buildReturningProcedure(VM vm, const char* name, size_t line) {
+  ByteCode code[] = { OpReturn };
+  UnstableNode debugData = buildRecord(
+    vm, buildArity(vm, "d", "file", "line"), "f.oz", line);
+  UnstableNode codeArea = CodeArea::build(vm, 0, code, sizeof(code),
+                                          0, 0, vm->getAtom(name),
+                                          debugData);
+  return new (vm) StableNode(vm, Abstraction::build(vm, 0, codeArea));
+}
+
+namespace mut {
 
 template <class C>
 void PrintTo(const BaseLString<C>& input, std::ostream* out) {
@@ -8,6 +8,12 @@ std::unique_ptr<mozart::VirtualMachineEnvironment> makeTestEnvironment();
 
 namespace mozart {
 
+/**
+ * Build a procedure that returns at once, with the debug data
+ * d(file:'f.oz' line:line) from which profiles and maps name it
+ */
+StableNode* buildReturningProcedure(VM vm, const char* name, size_t line);
+
 class MozartTest : public ::testing::Test {
 protected:
   MozartTest() : environment(makeTestEnvironment()),
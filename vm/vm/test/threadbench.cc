@@ -0,0 +1,22 @@
+#include "benchutils.hh"
+#include "testutils.hh"
+
+using namespace mozart;
+
+// Creation and scheduling of threads that return at once
+
+BENCHMARK_DEFINE_F(MozartBench, ThreadCreateRun)(benchmark::State& state) {
+  size_t count = state.range(0);
+
+  auto procedure = vm->protect(*buildReturningProcedure(vm, "f", 1));
+
+  for (auto _ : state) {
+    for (size_t i = 0; i < count; i++)
+      new (vm) Thread(vm, vm->getCurrentSpace(), *procedure);
+    vm->run();
+    collectIfNeeded(state);
+  }
+
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK_REGISTER_F(MozartBench, ThreadCreateRun)->Arg(1)->Arg(1000);
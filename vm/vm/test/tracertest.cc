@@ -0,0 +1,51 @@
+#include "mozart.hh"
+#include <gtest/gtest.h>
+#include <sstream>
+#include "testutils.hh"
+
+using namespace mozart;
+
+class TracerTest : public MozartTest {};
+
+TEST_F(TracerTest, Trace) {
+  auto& tracer = vm->getTracer();
+  EXPECT_FALSE(tracer.isEnabled());
+
+  tracer.start(4);
+  EXPECT_TRUE(tracer.isEnabled());
+
+  vm->requestGC();
+  vm->run();
+
+  UnstableNode variable = Variable::build(vm);
+  tracer.traceRun(7, tracer.now());
+  tracer.traceSuspend(7, variable);
+  tracer.traceResume(7);
+  tracer.stop();
+
+  EXPECT_EQ(4u, tracer.getEventCount());
+  auto events = tracer.getEvents();
+  ASSERT_EQ(4u, events.size());
+  EXPECT_EQ(TraceEvent::tekGC, events[0].kind);
+  EXPECT_EQ(0u, events[0].thread);
+  EXPECT_EQ(TraceEvent::tekRun, events[1].kind);
+  EXPECT_EQ(7u, events[1].thread);
+  EXPECT_EQ(TraceEvent::tekSuspend, events[2].kind);
+  EXPECT_STREQ("Variable", events[2].detail);
+
+  std::stringstream json;
+  tracer.dumpChromeTrace(json);
+  EXPECT_NE(std::string::npos, json.str().find("\"name\":\"gc\""));
+  EXPECT_NE(std::string::npos, json.str().find("\"name\":\"Thread 7\""));
+
+  // The buffer keeps the most recent events
+  tracer.start(2);
+  tracer.traceAlarm();
+  tracer.traceResume(1);
+  tracer.traceResume(2);
+  events = tracer.getEvents();
+  ASSERT_EQ(2u, events.size());
+  EXPECT_EQ(1u, events[0].thread);
+  EXPECT_EQ(2u, events[1].thread);
+  tracer.stop();
+}
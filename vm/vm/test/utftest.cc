@@ -270,3 +270,78 @@ TEST_F(UTFTest, CodePointCount) {
     U"\u0008\u0080\u0800\u8000\U00080000", 5)));
   EXPECT_EQ(2, codePointCount(makeLString(U"\0\0", 2)));
 }
+
+namespace {
+  // Mostly ASCII text, with multi-byte and invalid sequences sprinkled at
+  // positions which straddle the 8, 16 and 32-byte boundaries of the kernels.
+  std::vector<std::string> makeBulkTestInputs() {
+    const char* fragments[] = {
+      "\xc2\xa9", "\xe2\x89\xa0", "\xf0\x90\x80\x80", "\xf4\x8f\xbf\xbf",
+      "\xed\xa0\x80", "\xc0\x8a", "\xe2\x89", "\x80", "\xff"
+    };
+
+    std::vector<std::string> inputs;
+    for (size_t length = 0; length <= 70; ++length) {
+      std::string ascii;
+      for (size_t i = 0; i < length; ++i)
+        ascii += (char) ('!' + i % 90);
+      inputs.push_back(ascii);
+
+      for (auto fragment : fragments) {
+        for (size_t pos = 0; pos <= length; pos += 7)
+          inputs.push_back(ascii.substr(0, pos) + fragment + ascii.substr(pos));
+      }
+    }
+    return inputs;
+  }
+}
+
+TEST_F(UTFTest, BulkKernelsMatchScalar) {
+  SIMDLevel best = internal::detectSIMDLevel();
+  SIMDLevel levels[] = {
+    SIMDLevel::scalar, SIMDLevel::sse2, SIMDLevel::avx2
+  };
+
+  for (auto&& input : makeBulkTestInputs()) {
+    const char* utf = input.data();
+    nativeint length = input.size();
+    nativeint expected = internal::asciiPrefixLength(
+      utf, length, SIMDLevel::scalar);
+
+    for (auto level : levels) {
+      if (level > best)
+        break;
+
+      EXPECT_EQ(expected, internal::asciiPrefixLength(utf, length, level));
+
+      std::vector<char16_t> dest16(length + 1, 0xffff);
+      std::vector<char32_t> dest32(length + 1, 0xffff);
+      internal::widenASCII(utf, expected, dest16.data(), level);
+      internal::widenASCII(utf, expected, dest32.data(), level);
+      for (nativeint i = 0; i < expected; ++i) {
+        EXPECT_EQ((char16_t) utf[i], dest16[i]);
+        EXPECT_EQ((char32_t) utf[i], dest32[i]);
+      }
+      EXPECT_EQ(0xffff, dest16[expected]);
+      EXPECT_EQ(0xffff, dest32[expected]);
+    }
+  }
+}
+
+TEST_F(UTFTest, BulkUTF8ConversionMatchesScalar) {
+  for (auto&& input : makeBulkTestInputs()) {
+    auto str = makeLString(input.data(), input.size());
+
+    auto expected8 = ScalarUTFConvertor<char, char>::call(str);
+    auto expected16 = ScalarUTFConvertor<char16_t, char>::call(str);
+    auto expected32 = ScalarUTFConvertor<char32_t, char>::call(str);
+
+    EXPECT_EQ(expected8, toUTF<char>(str));
+    EXPECT_EQ(expected16, toUTF<char16_t>(str));
+    EXPECT_EQ(expected32, toUTF<char32_t>(str));
+
+    UnicodeErrorReason expectedError =
+      expected8.isError() ? expected8.error : UnicodeErrorReason::empty;
+    EXPECT_EQ(expectedError, validateUTF8(input.data(), input.size()));
+  }
+}
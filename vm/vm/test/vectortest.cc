@@ -0,0 +1,121 @@
+#include "mozart.hh"
+#include <gtest/gtest.h>
+#include "testutils.hh"
+
+using namespace mozart;
+
+class VectorTest : public MozartTest {};
+
+TEST_F(VectorTest, PushPop) {
+  UnstableNode vector = Vector::build(vm, 0);
+  auto v = RichNode(vector).as<Vector>();
+
+  for (nativeint i = 1; i <= 100; i++) {
+    UnstableNode value = build(vm, i * 10);
+    v.push(vm, value);
+  }
+
+  EXPECT_EQ(100u, v.getSize());
+  EXPECT_LE(100u, v.getCapacity());
+  UnstableNode size = v.size(vm);
+  EXPECT_EQ_INT(100, size);
+
+  for (nativeint i = 100; i >= 1; i--) {
+    UnstableNode popped = v.pop(vm);
+    EXPECT_EQ_INT(i * 10, popped);
+  }
+
+  EXPECT_EQ(0u, v.getSize());
+  EXPECT_RAISE("emptyVector", v.pop(vm));
+}
+
+TEST_F(VectorTest, GetPut) {
+  UnstableNode vector = Vector::build(vm, 4);
+  auto v = RichNode(vector).as<Vector>();
+
+  for (nativeint i = 0; i < 3; i++) {
+    UnstableNode value = build(vm, i);
+    v.push(vm, value);
+  }
+
+  UnstableNode index = build(vm, 2);
+  UnstableNode value = build(vm, 42);
+  v.put(vm, index, value);
+  UnstableNode got = v.get(vm, index);
+  EXPECT_EQ_INT(42, got);
+
+  UnstableNode first = build(vm, 1);
+  UnstableNode firstValue = v.get(vm, first);
+  EXPECT_EQ_INT(0, firstValue);
+
+  // Raising stores the vector in the exception, so it must be reread afterwards
+  UnstableNode zero = build(vm, 0);
+  EXPECT_RAISE("vectorIndexOutOfBounds",
+               RichNode(vector).as<Vector>().get(vm, zero));
+
+  UnstableNode four = build(vm, 4);
+  EXPECT_RAISE("vectorIndexOutOfBounds",
+               RichNode(vector).as<Vector>().put(vm, four, value));
+}
+
+TEST_F(VectorTest, ToTupleToList) {
+  UnstableNode vector = Vector::build(vm, 0);
+  auto v = RichNode(vector).as<Vector>();
+
+  UnstableNode label = build(vm, "t");
+  UnstableNode emptyTuple = v.toTuple(vm, label);
+  EXPECT_EQ_ATOM("t", emptyTuple);
+  UnstableNode emptyList = v.toList(vm);
+  EXPECT_EQ_ATOM("nil", emptyList);
+
+  for (nativeint i = 1; i <= 5; i++) {
+    UnstableNode value = build(vm, i);
+    v.push(vm, value);
+  }
+
+  UnstableNode tuple = v.toTuple(vm, label);
+  EXPECT_TRUE(RecordLike(tuple).isTuple(vm));
+  EXPECT_EQ(5u, RichNode(tuple).as<Tuple>().getWidth());
+  for (size_t i = 0; i < 5; i++)
+    EXPECT_EQ_INT(i + 1, *RichNode(tuple).as<Tuple>().getElement(i));
+
+  UnstableNode list = v.toList(vm);
+  EXPECT_EQ(5u, ozListLength(vm, list));
+  nativeint expected = 1;
+  ozListForEach(vm, list, [&] (nativeint elem) {
+    EXPECT_EQ(expected, elem);
+    expected++;
+  }, "list");
+}
+
+TEST_F(VectorTest, SurvivesGC) {
+  UnstableNode vector = Vector::build(vm, 0);
+  {
+    auto v = RichNode(vector).as<Vector>();
+    for (nativeint i = 1; i <= 1000; i++) {
+      UnstableNode value = build(vm, i);
+      v.push(vm, value);
+    }
+  }
+
+  auto protectedVector = vm->protect(vector);
+
+  vm->requestGC();
+  vm->run();
+
+  auto v = RichNode(*protectedVector).as<Vector>();
+  EXPECT_EQ(1000u, v.getSize());
+  EXPECT_EQ(1000u, v.getCapacity());
+
+  for (nativeint i = 1; i <= 1000; i++) {
+    UnstableNode index = build(vm, i);
+    UnstableNode got = v.get(vm, index);
+    EXPECT_EQ_INT(i, got);
+  }
+
+  UnstableNode value = build(vm, 1001);
+  v.push(vm, value);
+  EXPECT_EQ(1001u, v.getSize());
+  UnstableNode popped = v.pop(vm);
+  EXPECT_EQ_INT(1001, popped);
+}